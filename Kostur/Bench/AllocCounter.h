@@ -0,0 +1,15 @@
+#pragma once
+// Counts every heap allocation of the process. Replaces the global operator new, so
+// include it from one translation unit only: the bench's own.
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+static unsigned long long allocations = 0;
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
@@ -0,0 +1,88 @@
+// Concurrency check and throughput benchmark for BookingEngine. No GL needed:
+//   g++ -O2 -std=c++17 -pthread Bench/BookingBench.cpp Source/BookingEngine.cpp -o booking_bench
+//   booking_bench [rows cols]
+#include "../Header/BookingEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Every thread buys random-sized groups until the hall has no room left. Afterwards
+// each bought seat must belong to exactly one successful group and no seat may be
+// left locked.
+static bool checkGroups(int rows, int cols, int threads) {
+    BookingEngine engine(rows, cols);
+    std::vector<std::vector<int>> blocks(threads);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::mt19937 rng(t + 1);
+            int failures = 0;
+            while (failures < 8) {
+                int n = 1 + (int)(rng() % std::min(cols, 8));
+                int first = engine.buyBlock(n);
+                if (first < 0) { ++failures; continue; }
+                for (int k = 0; k < n; ++k) blocks[t].push_back(first + k);
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    std::vector<int> owner(engine.size(), 0);
+    for (auto& b : blocks) for (int seat : b) ++owner[seat];
+    for (int i = 0; i < engine.size(); ++i) {
+        bool bought = engine.state(i) == SEAT_BOUGHT;
+        if (owner[i] > 1 || bought != (owner[i] == 1) || engine.state(i) == SEAT_LOCKED) {
+            std::cerr << "seat " << i << ": state " << (int)engine.state(i) << ", owned by " << owner[i] << " groups\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Box-office mix per thread: 50% reserve/release clicks, 30% group buys, 20% cancels.
+// A thread resets the hall when its group buys stop finding room.
+static double throughput(int rows, int cols, int threads, double seconds) {
+    BookingEngine engine(rows, cols);
+    std::atomic<bool> stop{ false };
+    std::vector<unsigned long long> ops(threads, 0);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::mt19937 rng(t * 7919 + 1);
+            unsigned long long done = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                int seat = (int)(rng() % engine.size());
+                unsigned op = rng() % 10;
+                if (op < 5) engine.toggle(seat);
+                else if (op < 8) { if (engine.buyBlock(1 + (int)(rng() % 6)) < 0) engine.reset(); }
+                else engine.cancel(seat);
+                ++done;
+            }
+            ops[t] = done;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto& th : pool) th.join();
+    unsigned long long total = 0;
+    for (auto n : ops) total += n;
+    return total / seconds;
+}
+
+int main(int argc, char** argv) {
+    int rows = argc > 2 ? std::atoi(argv[1]) : 200;
+    int cols = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    for (int threads : { 2, 8, 32, 64 }) {
+        if (!checkGroups(rows, cols, threads)) { std::cerr << "FAILED with " << threads << " threads\n"; return 1; }
+    }
+    std::cout << "group acquisition consistent for 2..64 threads\n";
+
+    for (int threads : { 1, 2, 4, 8, 16, 32, 64 })
+        std::cout << threads << " threads: " << (unsigned long long)throughput(rows, cols, threads, 1.0) << " ops/s\n";
+    return 0;
+}
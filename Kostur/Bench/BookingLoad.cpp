@@ -0,0 +1,125 @@
+// Load generator for the booking server (movie --listen ADDRESS). Linux only:
+//   g++ -O2 -std=c++17 Bench/BookingLoad.cpp Source/BookingProtocol.cpp -o booking_load
+//   booking_load ADDRESS [connections] [ops per frame] [seconds] [seats]
+// Every connection keeps one frame of ops in flight (queries, toggles and small
+// group purchases on random seats) and sends the next one once its reply is in.
+// Prints ops per second and the mean frame round trip.
+#include "../Header/BookingProtocol.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+struct Client {
+    int fd;
+    std::vector<uint8_t> in;
+    std::chrono::steady_clock::time_point sent;
+};
+
+static int connectTo(const char* address) {
+    bool port = std::strspn(address, "0123456789") == std::strlen(address);
+    int fd;
+    if (port) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)std::atoi(address));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); return -1; }
+        int yes = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    }
+    else {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, address, sizeof(addr.sun_path) - 1);
+        if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); return -1; }
+    }
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { std::cerr << "usage: booking_load ADDRESS [connections] [depth] [seconds] [seats]\n"; return 1; }
+    int connections = argc > 2 ? std::atoi(argv[2]) : 4;
+    int depth = argc > 3 ? std::atoi(argv[3]) : 64;
+    double seconds = argc > 4 ? std::atof(argv[4]) : 3.0;
+    int seatCount = argc > 5 ? std::atoi(argv[5]) : 54;
+
+    std::vector<Client> clients;
+    for (int i = 0; i < connections; ++i) {
+        int fd = connectTo(argv[1]);
+        if (fd < 0) { std::cerr << "Cannot connect to " << argv[1] << "\n"; return 1; }
+        clients.push_back({ fd, {}, {} });
+    }
+
+    std::mt19937 rng(1);
+    std::vector<uint8_t> frame;
+    uint32_t nextId = 1;
+    auto sendFrame = [&](Client& c) {
+        frame.clear();
+        BookingProtocol::FrameWriter w(frame);
+        w.begin(nextId++);
+        for (int k = 0; k < depth; ++k) {
+            unsigned roll = rng() % 10;
+            uint32_t seat = rng() % seatCount;
+            if (roll < 5) w.op(BookingProtocol::QUERY, 0, &seat, 1);
+            else if (roll < 9) w.op(BookingProtocol::TOGGLE, 0, &seat, 1);
+            else w.op(BookingProtocol::BEST, 1 + rng() % 4);
+        }
+        w.end();
+        if (write(c.fd, frame.data(), frame.size()) != (ssize_t)frame.size()) { std::cerr << "short write\n"; std::exit(1); }
+        c.sent = std::chrono::steady_clock::now();
+    };
+
+    unsigned long long ops = 0, frames = 0, refused = 0;
+    double roundTrips = 0.0;
+    std::vector<pollfd> fds;
+    for (Client& c : clients) { fds.push_back({ c.fd, POLLIN, 0 }); sendFrame(c); }
+
+    uint8_t buffer[64 * 1024];
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        if (poll(fds.data(), fds.size(), 100) <= 0) continue;
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (!(fds[i].revents & POLLIN)) continue;
+            ssize_t n = read(fds[i].fd, buffer, sizeof(buffer));
+            if (n <= 0) { std::cerr << "server closed the connection\n"; return 1; }
+            Client& c = clients[i];
+            c.in.insert(c.in.end(), buffer, buffer + n);
+            if (c.in.size() < 4 || c.in.size() < BookingProtocol::read32(c.in.data())) continue;
+
+            // the whole reply frame is in
+            const uint8_t* r = c.in.data() + BookingProtocol::FRAME_HEADER;
+            uint16_t results = BookingProtocol::read16(c.in.data() + 8);
+            for (uint16_t k = 0; k < results; ++k) {
+                if (r[1] == BookingProtocol::CLOSED) ++refused;
+                uint16_t count = BookingProtocol::read16(r + 2);
+                r += BookingProtocol::RESULT_HEADER + (r[0] == BookingProtocol::QUERY ? (count + 3) / 4 * 4 : 0);
+            }
+            ops += results;
+            ++frames;
+            roundTrips += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - c.sent).count();
+            c.in.clear();
+            sendFrame(c);
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << connections << " connections x " << depth << " ops per frame: " << (unsigned long long)(ops / elapsed)
+              << " ops/s, frame round trip " << (frames ? roundTrips / frames : 0.0) << " us";
+    if (refused) std::cout << ", " << refused << " refused (booking closed)";
+    std::cout << "\n";
+    for (Client& c : clients) close(c.fd);
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Box-office load generator: the booking path of the app (a Theater: engine, seat
+// mirror, allocator, hold timers, versions) without GL, driven by a synthetic on-sale rush.
+//   cmake --build build --target box_office (links theater_core)
+//   box_office [rows cols] [ops] [zipf exponent] [seed]
+// Group sizes for buys follow a Zipf law over 1..min(cols, 10) (pairs and singles
+// dominate, big parties are rare). Mix: 40% reservation clicks, 40% group buys,
+// 20% cancellations (redrawn while nothing is left to cancel); when no group fits
+// any more the hall is reset for the next show. Reports ops/s, p50/p99/p999
+// latency per op and heap allocations.
+#include "../Header/Theater.h"
+#include "AllocCounter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+struct Latencies {
+    const char* name;
+    std::vector<float> us{};
+
+    void report() {
+        if (us.empty()) return;
+        std::sort(us.begin(), us.end());
+        auto at = [&](double q) { return us[std::min(us.size() - 1, (size_t)(q * us.size()))]; };
+        std::printf("  %-7s %9zu ops  p50 %7.3f us  p99 %7.3f us  p999 %8.3f us  max %8.3f us\n",
+                    name, us.size(), at(0.5), at(0.99), at(0.999), us.back());
+    }
+};
+
+static void run(int rows, int cols, long long ops, double zipf, unsigned seed) {
+    Theater hall(1280, 720, rows, cols);
+    const SeatMap& seats = hall.seats();
+    std::mt19937 rng(seed);
+    int maxGroup = std::min(cols, 10);
+    std::vector<double> weights;
+    for (int k = 1; k <= maxGroup; ++k) weights.push_back(1.0 / std::pow(k, zipf));
+    std::discrete_distribution<int> groupSize(weights.begin(), weights.end());
+    std::uniform_int_distribution<int> anySeat(0, seats.size() - 1);
+
+    Latencies toggles{ "toggle" }, buys{ "buy" }, cancels{ "cancel" }, resets{ "reset" };
+    for (Latencies* l : { &toggles, &buys, &cancels }) l->us.reserve((size_t)(ops * 0.45));
+    resets.us.reserve(1 << 16);
+    std::vector<int> taken; // seats handed out, candidates for cancellation (may be stale)
+    taken.reserve(seats.size() * 2);
+    unsigned long long groupsSold = 0, seatsSold = 0;
+
+    unsigned long long allocBefore = allocations;
+    auto begin = std::chrono::steady_clock::now();
+    for (long long i = 0; i < ops; ++i) {
+        if (i % 100 == 0) hall.update(0.1); // 1 ms of virtual time per op
+        hall.clearDirtySeats();
+        unsigned roll;
+        do roll = rng() % 10; while (roll >= 8 && taken.empty()); // nothing to cancel: another op
+        auto t0 = std::chrono::steady_clock::now();
+        Latencies* l;
+        bool bought = false;
+        if (roll < 4) {
+            int seat = anySeat(rng);
+            hall.toggleSeat(seat);
+            if (seats.state(seat) == SEAT_RESERVED) taken.push_back(seat);
+            l = &toggles;
+        }
+        else if (roll < 8) {
+            int n = groupSize(rng) + 1;
+            if (hall.buyNSeats(n)) {
+                bought = true;
+                ++groupsSold; seatsSold += n;
+                l = &buys;
+            }
+            else {
+                hall.booking().reset(); // sold out: next show
+                hall.syncBookings();
+                taken.clear();
+                l = &resets;
+            }
+        }
+        else {
+            size_t k = rng() % taken.size();
+            hall.booking().cancel(taken[k]);
+            hall.syncBookings();
+            taken[k] = taken.back();
+            taken.pop_back();
+            l = &cancels;
+        }
+        l->us.push_back(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - t0).count());
+        if (bought) taken.insert(taken.end(), hall.dirtySeats().begin(), hall.dirtySeats().end()); // the block
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    unsigned long long allocs = allocations - allocBefore;
+
+    std::printf("hall %dx%d (%d seats), zipf %.2f over 1..%d: %lld ops in %.2f s, %.0f ops/s\n",
+                rows, cols, seats.size(), zipf, maxGroup, ops, seconds, ops / seconds);
+    for (Latencies* l : { &toggles, &buys, &cancels, &resets }) l->report();
+    std::printf("  %llu groups / %llu seats sold, %zu holds pending, %llu allocations (%.4f per op)\n",
+                groupsSold, seatsSold, hall.pendingHolds(), allocs, (double)allocs / ops);
+}
+
+int main(int argc, char** argv) {
+    long long ops = argc > 3 ? std::atoll(argv[3]) : 2000000;
+    double zipf = argc > 4 ? std::atof(argv[4]) : 1.2;
+    unsigned seed = argc > 5 ? (unsigned)std::atoi(argv[5]) : 1;
+    if (argc > 2) { run(std::atoi(argv[1]), std::atoi(argv[2]), ops, zipf, seed); return 0; }
+    run(6, 9, ops, zipf, seed);       // default hall
+    run(40, 50, ops, zipf, seed);     // multiplex screen
+    run(200, 100, ops, zipf, seed);   // arena
+    run(500, 400, ops, zipf, seed);   // stadium
+    return 0;
+}
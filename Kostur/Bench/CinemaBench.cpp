@@ -0,0 +1,92 @@
+// Cinema chain load: many multiplexes of many halls, several shows per hall per day,
+// all in one process on a Cinema. Per day every show is created, sold through group
+// buys, played (update() at 60 Hz until every show is over) and destroyed.
+//   g++ -O2 -std=c++17 -pthread Bench/CinemaBench.cpp Source/Cinema.cpp Source/ThreadPool.cpp Source/SeatMap.cpp -o cinema_bench
+//   cinema_bench [multiplexes] [halls per multiplex] [shows per hall] [threads] [days]
+// Reports the time per phase, update() latency per frame and heap allocations; from
+// the second day on shows reuse the blocks of the previous one.
+#include "../Header/Cinema.h"
+#include "AllocCounter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+static double msSince(Clock::time_point t) { return std::chrono::duration<double, std::milli>(Clock::now() - t).count(); }
+
+int main(int argc, char** argv) {
+    int multiplexes = argc > 1 ? std::atoi(argv[1]) : 100;
+    int hallsPer = argc > 2 ? std::atoi(argv[2]) : 20;
+    int showsPer = argc > 3 ? std::atoi(argv[3]) : 4;
+    int threads = argc > 4 ? std::atoi(argv[4]) : 0;
+    int days = argc > 5 ? std::atoi(argv[5]) : 2;
+
+    Cinema cinema(threads);
+    std::mt19937 rng(1);
+    size_t seats = 0, bytes = 0;
+    for (int i = 0; i < multiplexes * hallsPer; ++i) {
+        SeatMap layout;
+        layout.resizeGrid(6 + rng() % 15, 9 + rng() % 22, { 120.0f, 140.0f, 1040.0f, 440.0f }); // 54 to 600 seats, the default hall's area
+        int hall = cinema.addHall(layout, { 30.0f, 690.0f });
+        seats += cinema.hallSeats(hall);
+        bytes += cinema.showBytes(hall);
+    }
+    int halls = cinema.hallCount();
+    std::printf("%d halls, %zu seats, %.0f bytes per show on average, %d threads\n",
+                halls, seats, (double)bytes / halls, cinema.threads());
+
+    std::vector<int> shows;
+    shows.reserve((size_t)halls * showsPer);
+    std::vector<float> frameMs;
+    frameMs.reserve(1 << 16);
+    std::geometric_distribution<int> groupSize(0.45); // pairs and singles dominate
+    for (int day = 1; day <= days; ++day) {
+        unsigned long long allocBefore = allocations, blocksBefore = cinema.blockAllocations();
+        auto t = Clock::now();
+        for (int hall = 0; hall < halls; ++hall)
+            for (int k = 0; k < showsPer; ++k) shows.push_back(cinema.createShow(hall));
+        double createMs = msSince(t);
+
+        t = Clock::now();
+        unsigned long long sold = 0;
+        for (int show : shows) {
+            for (int misses = 0; misses < 3;) { // until three groups in a row did not fit
+                int n = std::min(groupSize(rng) + 1, 10);
+                if (cinema.buyNSeats(show, n, rng() % 4 ? SeatPolicy::Center : SeatPolicy::BackRightmost)) { sold += n; misses = 0; }
+                else ++misses;
+            }
+            cinema.startShow(show, (unsigned)rng() | 1);
+        }
+        double sellMs = msSince(t);
+
+        t = Clock::now();
+        frameMs.clear();
+        unsigned long long people = 0;
+        for (int show : shows) people += cinema.audience(show);
+        while (cinema.runningShows() > 0) {
+            auto f = Clock::now();
+            cinema.update(1.0 / 60.0);
+            frameMs.push_back((float)msSince(f));
+        }
+        double playMs = msSince(t);
+
+        t = Clock::now();
+        for (int show : shows) cinema.destroyShow(show);
+        double destroyMs = msSince(t);
+
+        std::sort(frameMs.begin(), frameMs.end());
+        auto at = [&](double q) { return frameMs[std::min(frameMs.size() - 1, (size_t)(q * frameMs.size()))]; };
+        std::printf("day %d: %zu shows, %llu seats sold, %llu people\n", day, shows.size(), sold, people);
+        std::printf("  create %.2f ms (%.3f us/show), sell %.2f ms, destroy %.2f ms (%.3f us/show)\n",
+                    createMs, createMs * 1000.0 / shows.size(), sellMs, destroyMs, destroyMs * 1000.0 / shows.size());
+        std::printf("  play %.2f s: %zu frames, update p50 %.3f ms  p99 %.3f ms  max %.3f ms\n",
+                    playMs / 1000.0, frameMs.size(), at(0.5), at(0.99), frameMs.back());
+        std::printf("  %llu show blocks allocated, %llu allocations in total\n",
+                    cinema.blockAllocations() - blocksBefore, allocations - allocBefore);
+        shows.clear();
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Decoder fuzz check and throughput benchmark for the booking protocol. No GL or
+// sockets needed:
+//   g++ -O2 -std=c++17 -pthread Bench/ProtocolBench.cpp Source/BookingProtocol.cpp Source/BookingServer.cpp Source/BookingEngine.cpp -o protocol_bench
+//   protocol_bench [fuzz iterations]
+// Build with -fsanitize=address,undefined to have out-of-bounds reads reported.
+#include "../Header/BookingProtocol.h"
+#include "../Header/BookingEngine.h"
+#include "../Header/BookingServer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace BookingProtocol;
+
+static void randomFrame(std::mt19937& rng, std::vector<uint8_t>& out, int seats) {
+    FrameWriter w(out);
+    w.begin(rng());
+    int ops = 1 + rng() % 8;
+    uint32_t list[16];
+    for (int k = 0; k < ops; ++k) {
+        uint16_t count = (uint16_t)(rng() % 5);
+        for (int i = 0; i < count; ++i) list[i] = rng() % seats;
+        w.op((Code)(1 + rng() % 6), rng() % 5, list, count);
+    }
+    w.end();
+}
+
+// A reply walked by the documented layout must hold one result per op, in order,
+// and end exactly at its size (a result with state bytes not described by its
+// count would shift every result after it)
+static bool walkReply(const std::vector<uint8_t>& reply, const std::vector<uint8_t>& frame, uint16_t ops) {
+    if (reply.size() < FRAME_HEADER || read32(&reply[0]) != reply.size() || read16(&reply[8]) != ops) return false;
+    FrameView view;
+    decodeFrame(frame.data(), frame.size(), view);
+    size_t pos = FRAME_HEADER;
+    OpView op;
+    for (uint16_t i = 0; i < ops; ++i) {
+        view.next(op);
+        if (pos + RESULT_HEADER > reply.size() || reply[pos] != op.code) return false;
+        uint16_t count = read16(&reply[pos + 2]);
+        pos += RESULT_HEADER + (reply[pos] == QUERY ? (count + 3) / 4 * 4 : 0);
+    }
+    return pos == reply.size();
+}
+
+// Mutated and truncated frames must be rejected or accepted consistently: never
+// read past the buffer (the copy is sized exactly, so ASan catches it), a frame
+// the decoder accepts must walk to exactly its size, and so must its reply.
+static bool fuzz(int iterations) {
+    std::mt19937 rng(7);
+    BookingEngine engine(20, 20);
+    BookingServer server(engine);
+    std::vector<uint8_t> frame, reply;
+    for (int it = 0; it < iterations; ++it) {
+        frame.clear();
+        randomFrame(rng, frame, engine.size() + 4);
+        int flips = rng() % 4;
+        for (int f = 0; f < flips; ++f) frame[rng() % frame.size()] ^= (uint8_t)(1u << (rng() % 8));
+        if (rng() % 4 == 0) frame.resize(rng() % frame.size());
+
+        std::vector<uint8_t> exact(frame);
+        const uint8_t* data = exact.empty() ? nullptr : exact.data();
+        FrameView view;
+        long n = decodeFrame(data, exact.size(), view);
+        if (n > 0) {
+            OpView op;
+            for (uint16_t i = 0; i < view.ops; ++i) view.next(op);
+            if (view.cursor != data + n) { std::cerr << "iteration " << it << ": ops do not end at the frame size\n"; return false; }
+        }
+        reply.clear();
+        long used = server.process(data, exact.size(), reply);
+        if (used != (n > 0 ? n : n < 0 ? -1 : 0)) { std::cerr << "iteration " << it << ": process disagrees with decodeFrame\n"; return false; }
+        if (n > 0 && !walkReply(reply, exact, view.ops)) { std::cerr << "iteration " << it << ": reply does not follow the result layout\n"; return false; }
+    }
+    return true;
+}
+
+// Many frames back to back in one buffer, as one read() would deliver them
+static void throughput(int opsPerFrame) {
+    BookingEngine engine(40, 50);
+    BookingServer server(engine);
+    std::mt19937 rng(3);
+    std::vector<uint8_t> stream, reply;
+    const int frames = 4096;
+    for (int f = 0; f < frames; ++f) {
+        FrameWriter w(stream);
+        w.begin(f);
+        for (int k = 0; k < opsPerFrame; ++k) {
+            uint32_t seat = rng() % engine.size();
+            if (k % 2) w.op(QUERY, 0, &seat, 1);
+            else w.op(TOGGLE, 0, &seat, 1);
+        }
+        w.end();
+    }
+    reply.reserve(stream.size());
+    auto start = std::chrono::steady_clock::now();
+    long long ops = 0;
+    for (int rep = 0; rep < 20; ++rep) {
+        reply.clear();
+        if (server.process(stream.data(), stream.size(), reply) != (long)stream.size()) { std::cerr << "short parse\n"; return; }
+        ops += (long long)frames * opsPerFrame;
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << opsPerFrame << " ops per frame: " << (long long)(ops / s) << " ops/s, "
+              << (long long)(ops / opsPerFrame / s) << " frames/s\n";
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+    if (!fuzz(iterations)) return 1;
+    std::cout << "fuzz: " << iterations << " mutated frames ok\n";
+    for (int ops : { 1, 8, 64 }) throughput(ops);
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Consistent reads under bookings: one writer changes seats and publishes a version
+// per frame on SeatVersions while reader threads take views and check them.
+//   g++ -O2 -std=c++17 -pthread Bench/SnapshotBench.cpp Source/SeatVersions.cpp -o snapshot_bench
+//   snapshot_bench [rows cols] [readers] [seconds] [changes per publish]
+// The writer always changes seat i and its mirror size-1-i in the same version, which
+// mostly sit in different chunks; a reader that saw half of such a change (a torn
+// view) finds the pair different. Reports publishes/s, chunks copied per publish
+// against copying the whole hall, and reads/s.
+#include "../Header/SeatVersions.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    int rows = argc > 2 ? std::atoi(argv[1]) : 200;
+    int cols = argc > 2 ? std::atoi(argv[2]) : 100;
+    int readers = argc > 3 ? std::atoi(argv[3]) : 3;
+    double seconds = argc > 4 ? std::atof(argv[4]) : 2.0;
+    int changes = argc > 5 ? std::atoi(argv[5]) : 16;
+    int size = rows * cols;
+
+    SeatVersions versions;
+    versions.init(rows, cols, nullptr);
+    std::atomic<bool> done{ false };
+    std::atomic<unsigned long long> reads{ 0 }, torn{ 0 }, stale{ 0 }, refused{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(t + 1);
+            unsigned long long n = 0, bad = 0, backwards = 0, busy = 0;
+            uint64_t last = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                SeatView view = versions.read();
+                if (!view.valid()) { ++busy; continue; } // every slot taken
+                if (view.version() < last) ++backwards;
+                last = view.version();
+                // a few pairs at random, and every tenth view the whole hall (an export)
+                int checks = n % 10 == 0 ? size / 2 : 64;
+                for (int k = 0; k < checks; ++k) {
+                    int i = n % 10 == 0 ? k : (int)(rng() % size);
+                    if (view.state(i) != view.state(size - 1 - i)) ++bad;
+                }
+                ++n;
+            }
+            reads += n; torn += bad; stale += backwards; refused += busy;
+        });
+    }
+
+    std::mt19937 rng(42);
+    unsigned long long publishes = 0;
+    unsigned long long copiedBefore = versions.copiedChunks();
+    size_t maxRetired = 0;
+    auto begin = std::chrono::steady_clock::now();
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < seconds) {
+        for (int k = 0; k < changes; ++k) {
+            int i = (int)(rng() % size);
+            uint8_t state = (uint8_t)(rng() % 3);
+            versions.set(i, state);
+            versions.set(size - 1 - i, state);
+        }
+        versions.publish();
+        ++publishes;
+        if (versions.retiredVersions() > maxRetired) maxRetired = versions.retiredVersions();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    done = true;
+    for (std::thread& t : threads) t.join();
+
+    double copied = (double)(versions.copiedChunks() - copiedBefore) / publishes;
+    std::printf("hall %dx%d, %d chunks of %zu bytes, %d readers, %d seat pairs per version\n",
+                rows, cols, versions.chunkCount(), versions.chunkBytes(), readers, changes);
+    std::printf("  %llu publishes (%.0f/s), %.1f chunks copied per publish: %.0f bytes instead of %d\n",
+                publishes, publishes / elapsed, copied, copied * versions.chunkBytes(), size);
+    std::printf("  %llu views (%.0f/s), %llu refused, %llu torn pairs, %llu versions going backwards, at most %zu versions waiting for readers\n",
+                reads.load(), reads.load() / elapsed, refused.load(), torn.load(), stale.load(), maxRetired);
+    return torn.load() || stale.load() ? 1 : 0;
+}
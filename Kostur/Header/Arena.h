@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+
+// Bump allocator over a block the caller owns. Nothing is freed piecemeal: whatever
+// is carved out goes away with the block. Given a null block it only measures, so
+// the same carving code sizes the block first and fills it afterwards.
+class Arena {
+public:
+    Arena(void* block, size_t size) : base(static_cast<char*>(block)), capacity(size) {}
+
+    // n uninitialized Ts (trivial types only); nullptr when measuring or out of room
+    template<class T> T* alloc(size_t n) {
+        size_t start = (offset + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (start + n * sizeof(T) > capacity) return nullptr;
+        offset = start + n * sizeof(T);
+        return base ? reinterpret_cast<T*>(base + start) : nullptr;
+    }
+
+    size_t used() const { return offset; }
+
+private:
+    char* base;
+    size_t capacity;
+    size_t offset = 0;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SeatAllocator.h"
+
+// Seat states shared by the booking code (same values as SeatMap)
+enum : uint8_t {
+    SEAT_FREE = 0,
+    SEAT_RESERVED = 1,
+    SEAT_BOUGHT = 2,
+    SEAT_EMPTY = 3,  // no seat in this layout slot
+    SEAT_LOCKED = 4  // held for a moment by a group acquisition in progress
+};
+
+// Booking for many threads at once without a global lock. Every seat is an atomic
+// byte changed only by compare-and-swap (free -> reserved -> bought, and back on
+// cancel). A group is acquired by locking its seats one by one; if any of them is
+// taken meanwhile the locked ones are released again, so a group is never bought
+// in part. It is not published at once though: while acquire runs, a reader may
+// see some of its seats already bought and the rest SEAT_LOCKED. Changed seats are
+// flagged in an atomic bitmap that the render thread drains each frame.
+class BookingEngine {
+public:
+    BookingEngine(int rows, int cols, const uint8_t* initialStates = nullptr);
+
+    int size() const { return rows * cols; }
+    int rowCount() const { return rows; }
+    int colCount() const { return cols; }
+    uint8_t state(int seat) const { return seats[seat].load(std::memory_order_acquire); } // SEAT_LOCKED included
+
+    bool reserve(int seat); // free -> reserved
+    bool release(int seat); // reserved -> free
+    bool buy(int seat);     // free or reserved -> bought
+    bool cancel(int seat);  // reserved or bought -> free
+    bool toggle(int seat);  // free <-> reserved, as a click does
+
+    // All-or-nothing: every listed seat goes free -> to, or none does
+    bool acquire(const int* list, int n, uint8_t to);
+
+    // buyNSeats: n adjacent free seats where SeatAllocator::find would put them under
+    // policy. Retries with randomized back-off when another thread takes part of the
+    // block. Returns the first seat of the block, -1 when no row has room.
+    int buyBlock(int n, SeatPolicy policy = SeatPolicy::BackRightmost);
+
+    // The policy the hall's owner books with, for whoever books on its behalf (the
+    // booking server)
+    SeatPolicy blockPolicy() const { return policy.load(std::memory_order_relaxed); }
+    void setBlockPolicy(SeatPolicy p) { policy.store(p, std::memory_order_relaxed); }
+
+    void reset(); // reserved and bought seats become free
+
+    // Appends every seat changed since the previous call (single consumer)
+    void collectChanges(std::vector<int>& out);
+
+    unsigned long long conflicts() const { return conflictCount.load(std::memory_order_relaxed); }
+
+private:
+    bool transition(int seat, uint8_t from, uint8_t to);
+    int findBlock(int n, SeatPolicy policy) const;
+    int centerBlock(int row, int n) const;
+    void markChanged(int seat);
+
+    int rows, cols;
+    std::unique_ptr<std::atomic<uint8_t>[]> seats;
+    std::unique_ptr<std::atomic<uint64_t>[]> changed;
+    std::atomic<unsigned long long> conflictCount{ 0 };
+    std::atomic<SeatPolicy> policy{ SeatPolicy::BackRightmost };
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Binary booking protocol; little-endian, fixed layouts, no padding between fields.
+//   frame   uint32 size (whole frame, header included), uint32 id, uint16 ops, uint16 zero
+//   op      uint8 code, uint8 zero, uint16 count, uint32 arg, then count uint32 seats
+// The reply to a frame carries the same id and one result per op, in order:
+//   result  uint8 code, uint8 status, uint16 count, int32 value
+//           QUERY results are followed by count state bytes, padded to 4
+//           (SeatMap values; a seat held by a group being bought reads FREE.
+//           BAD results, QUERY included, carry count 0)
+// Clients may send frames back to back without waiting; the server answers all the
+// frames of one read with one write.
+namespace BookingProtocol {
+    const size_t FRAME_HEADER = 12;
+    const size_t OP_HEADER = 8;
+    const size_t RESULT_HEADER = 8;
+    const uint32_t MAX_FRAME = 64 * 1024;
+
+    enum Code : uint8_t {
+        RESERVE = 1, // seats: all free -> reserved, or none
+        BUY = 2,     // seats: all free -> bought, or none; a single seat may also be reserved
+        CANCEL = 3,  // seats: each reserved or bought -> free; value = how many were
+        QUERY = 4,   // seats: states follow the result
+        BEST = 5,    // arg = n adjacent seats as with keys 1-9, placed by the window's policy; value = first seat
+        TOGGLE = 6   // seats: each free <-> reserved, as a click; value = how many changed
+    };
+
+    enum Status : uint8_t { OK = 0, NO = 1, CLOSED = 2, BAD = 3 };
+
+    inline uint16_t read16(const uint8_t* p) { uint16_t v; std::memcpy(&v, p, 2); return v; }
+    inline uint32_t read32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+    // One op, pointing into the receive buffer
+    struct OpView {
+        uint8_t code;
+        uint16_t count;
+        uint32_t arg;
+        const uint8_t* seats;
+        uint32_t seat(int i) const { return read32(seats + 4 * i); }
+    };
+
+    // A validated frame in place; next() walks its ops without further checks
+    struct FrameView {
+        uint32_t id = 0;
+        uint16_t ops = 0;
+        const uint8_t* cursor = nullptr;
+
+        void next(OpView& op) {
+            op.code = cursor[0];
+            op.count = read16(cursor + 2);
+            op.arg = read32(cursor + 4);
+            op.seats = cursor + OP_HEADER;
+            cursor += OP_HEADER + 4 * (size_t)op.count;
+        }
+    };
+
+    // Looks at the first frame in data: its size when complete and well formed,
+    // 0 when more bytes are needed, -1 when it can never be valid
+    long decodeFrame(const uint8_t* data, size_t size, FrameView& frame);
+
+    // Builds frames in a byte buffer (clients, benches)
+    class FrameWriter {
+    public:
+        explicit FrameWriter(std::vector<uint8_t>& out) : out(out) {}
+        void begin(uint32_t id);
+        void op(Code code, uint32_t arg, const uint32_t* seats = nullptr, uint16_t count = 0);
+        void end(); // patches size and op count
+
+    private:
+        std::vector<uint8_t>& out;
+        size_t start = 0;
+        uint16_t ops = 0;
+    };
+
+    // Reply side, used by the server: a reply starts at out.size() before beginReply,
+    // endReply patches its size from that offset
+    void beginReply(std::vector<uint8_t>& out, uint32_t id, uint16_t ops);
+    void result(std::vector<uint8_t>& out, uint8_t code, Status status, uint16_t count, int32_t value);
+    void endReply(std::vector<uint8_t>& out, size_t start);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BookingProtocol.h"
+
+class BookingEngine;
+
+// Booking for outside clients: an epoll loop on its own thread accepting connections
+// on a Unix socket or a localhost TCP port, speaking the binary protocol of
+// BookingProtocol.h. Frames are decoded where they were received and applied
+// straight to the BookingEngine; the render thread picks the changes up with
+// collectChanges(). Booking ops while the film runs are answered CLOSED, queries
+// still work. Replies go out as soon as the engine has the change; it reaches the
+// seat log with the next frame's sync. A client that sends without reading its
+// replies is not read from while more than MAX_PENDING reply bytes wait for it.
+// Linux only; start() fails elsewhere.
+class BookingServer {
+public:
+    static constexpr size_t MAX_PENDING = 4 * BookingProtocol::MAX_FRAME; // unsent reply bytes per connection
+
+    explicit BookingServer(BookingEngine& engine) : engine(engine) {}
+    BookingServer(const BookingServer&) = delete;
+    BookingServer& operator=(const BookingServer&) = delete;
+    ~BookingServer() { stop(); }
+
+    bool start(const char* address); // "PORT" for 127.0.0.1:PORT, anything else is a socket path
+    void stop();
+    bool running() const { return loop.joinable(); }
+
+    // Closing returns once no booking op that saw the booking open is still running,
+    // so a sync right after it sees every booking the server answered OK
+    void setOpen(bool open);
+    unsigned long long requests() const { return requestCount.load(std::memory_order_relaxed); } // ops
+
+    // Answers every complete frame at the start of data into reply; returns the bytes
+    // consumed, -1 on a malformed frame. Used by the loop, callable without sockets.
+    long process(const uint8_t* data, size_t size, std::vector<uint8_t>& reply);
+
+private:
+    struct Connection {
+        explicit Connection(int f) : fd(f) {}
+        int fd;
+        std::vector<uint8_t> in; // room for two frames, filled straight by read()
+        size_t received = 0;
+        std::vector<uint8_t> out;
+        bool writing = false; // waiting for EPOLLOUT
+        bool reading = true;  // EPOLLIN armed; off while out holds more than MAX_PENDING
+    };
+
+    void run();
+    void accept();
+    void receive(Connection& c);
+    bool flush(Connection& c);
+    void execute(const BookingProtocol::OpView& op, std::vector<uint8_t>& reply);
+    void book(const BookingProtocol::OpView& op, std::vector<uint8_t>& reply); // booking open
+    void drop(int fd);
+
+    BookingEngine& engine;
+    std::thread loop;
+    int listenFd = -1, epollFd = -1, wakeFd = -1;
+    std::string socketPath;
+    std::vector<std::unique_ptr<Connection>> connections; // indexed by fd, loop thread only
+    std::vector<int> group; // seats of a multi-seat op
+    std::atomic<bool> bookingOpen{ true };
+    std::atomic<int> inFlight{ 0 }; // booking ops past the open check
+    std::atomic<unsigned long long> requestCount{ 0 };
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SeatAllocator.h"
+#include "SeatMap.h"
+#include "SimTypes.h"
+#include "ThreadPool.h"
+
+class Arena;
+
+enum class ShowPhase : uint8_t {
+    Selling,  // seats can be booked
+    Entering, // the audience walks to its seats
+    Playing,
+    Leaving,
+    Over      // everybody is out; bookings stay as they were sold
+};
+
+// A cinema chain in one process: halls (seat layouts, shared by their shows) and any
+// number of shows, each with its own seat states and crowd. Everything a show owns
+// sits in one block carved up by an Arena (seat bytes, then the people as parallel
+// arrays), and blocks of a hall's destroyed shows are kept for its next ones, so
+// creating or destroying a show costs at most one allocation and usually none.
+//
+// update() ticks every running show on a thread pool, a show on one thread at a
+// time. The booking calls are meant for the thread that calls update() (a show's
+// seats may be booked from elsewhere only while no update() runs).
+//
+// A hall or show id that is out of range or destroyed is refused: false, -1, 0,
+// SEAT_EMPTY, ShowPhase::Over or the origin, and startShow does nothing.
+class Cinema {
+public:
+    explicit Cinema(int threads = 0); // 0: one per hardware thread
+    Cinema(const Cinema&) = delete;
+    Cinema& operator=(const Cinema&) = delete;
+    ~Cinema();
+
+    // Copies the seat centers and empty slots of layout; entrance as in Theater
+    int addHall(const SeatMap& layout, Point entrance);
+    int hallCount() const { return (int)halls.size(); }
+    int hallSeats(int hall) const;
+
+    int createShow(int hall); // seats as the layout has them, phase Selling
+    void destroyShow(int show);
+    int showCount() const { return liveShows; }
+
+    // Booking (Selling only): states as in SeatMap
+    bool toggleSeat(int show, int seat);
+    bool buyNSeats(int show, int n, SeatPolicy policy = SeatPolicy::BackRightmost);
+    uint8_t seatState(int show, int seat) const;
+    int freeSeats(int show) const;
+
+    // A random part of the booking holders comes in (seed 0: random audience)
+    void startShow(int show, unsigned int seed = 0);
+    ShowPhase phase(int show) const;
+    int audience(int show) const;
+    Point personAt(int show, int person) const;
+
+    // Advances every running show by elapsed seconds in fixed Sim::SIM_DT ticks
+    void update(double elapsed);
+    int runningShows() const { return (int)running.size(); }
+
+    size_t showBytes(int hall) const; // one block per show
+    unsigned long long blockAllocations() const { return allocatedBlocks; }
+    int threads() const { return pool.size(); }
+
+private:
+    struct Hall;
+    struct Show;
+
+    static Show* carve(Arena& arena, int seats); // null while measuring
+    Show* find(int show) const; // null if there is no such show
+    void stop(Show& s); // off the running list
+    static void step(Show& s, float dt, int ticks);
+
+    std::vector<std::unique_ptr<Hall>> halls;
+    std::vector<Show*> shows; // by id, null for free ids
+    std::vector<int> freeIds;
+    std::vector<Show*> running;
+    int liveShows = 0;
+    unsigned long long allocatedBlocks = 0;
+    float accumulator = 0.0f;
+    ThreadPool pool;
+};
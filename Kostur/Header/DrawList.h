@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <glm/glm.hpp>
+
+class Shader;
+
+// Collects the colored quads of one frame into a single vertex stream.
+// The stream is uploaded once per frame and drawn in submission order;
+// custom() splices arbitrary GL work (e.g. instanced seats) between batches.
+class DrawList {
+public:
+    void init();
+    void destroy();
+
+    void begin();
+    void quad(float x, float y, float w, float h, const glm::vec4& color);
+    void custom(std::function<void()> fn);
+    void submit(const Shader& shader);
+
+    int drawCalls() const { return lastDrawCalls; }
+    int quadCount() const { return (int)verts.size() / 6; }
+
+private:
+    struct Vertex { float x, y, r, g, b, a; };
+    struct Cmd {
+        int first, count;          // vertex range, used when fn is empty
+        std::function<void()> fn;
+    };
+
+    std::vector<Vertex> verts;
+    std::vector<Cmd> cmds;
+    unsigned int vao = 0, vbo = 0;
+    size_t capacity = 0; // bytes allocated in vbo
+    int lastDrawCalls = 0;
+};
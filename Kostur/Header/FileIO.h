@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Thin portable layer over the POSIX / CRT file calls used by the seat log and
+// snapshots. All functions return false (or -1 for descriptors) on failure.
+namespace FileIO {
+    int openAppend(const char* path);  // creates the file if needed
+    int openWrite(const char* path);   // creates or truncates
+    int openRead(const char* path);
+    void close(int fd);
+    bool writeAll(int fd, const void* data, size_t size);
+    bool syncData(int fd);             // fdatasync / _commit
+    bool readAll(const char* path, std::vector<uint8_t>& out); // false if it cannot be opened
+    bool readAt(int fd, uint64_t offset, void* data, size_t size); // exactly size bytes
+    bool truncate(const char* path, uint64_t size);
+    bool truncate(int fd, uint64_t size);        // and moves the file position there
+    bool replace(const char* from, const char* to); // atomic rename over 'to', then syncs the directory
+    bool remove(const char* path);
+    int64_t fileSize(int fd);          // -1 on failure
+
+    uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
+}
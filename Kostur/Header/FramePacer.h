@@ -0,0 +1,30 @@
+#pragma once
+#include <chrono>
+
+// Holds the main loop to a fixed frame rate. Deadlines are absolute (start + n * period),
+// so a late frame does not push every later one back. Waiting sleeps coarsely until
+// shortly before the deadline and spins the rest, since sleep_for alone oversleeps by
+// up to a scheduler quantum. With vsync the swap already blocks; the pacer then only
+// watches for frames that took longer than the period.
+class FramePacer {
+public:
+    void start(double fps, bool vsync = false);
+    void wait(); // call once per frame, after the swap
+
+    // sleep is only trusted up to this far before the deadline, the remainder is spun
+    void setSpinMargin(std::chrono::microseconds margin) { spinMargin = margin; }
+
+    bool vsync() const { return useVsync; }
+    unsigned long long frames() const { return frameCount; }
+    unsigned long long missedDeadlines() const { return missed; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::duration period{};
+    Clock::time_point deadline;
+    Clock::time_point lastFrame;
+    std::chrono::microseconds spinMargin{ 2000 };
+    bool useVsync = false;
+    unsigned long long frameCount = 0;
+    unsigned long long missed = 0;
+};
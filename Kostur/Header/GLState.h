@@ -0,0 +1,33 @@
+#pragma once
+
+// Thin cache in front of the GL binding calls. Every bind made by the app goes
+// through here, so a call that would not change the current binding is dropped.
+// Objects must be deleted through the delete* helpers so a recycled name is
+// never mistaken for the one that is still cached.
+namespace GLState {
+    struct Counters {
+        unsigned long long issued = 0;  // calls forwarded to GL
+        unsigned long long skipped = 0; // redundant calls filtered out
+    };
+
+    void useProgram(unsigned int program);
+    void bindVertexArray(unsigned int vao);
+    void bindBuffer(unsigned int target, unsigned int buffer);
+    void bindBufferBase(unsigned int target, unsigned int index, unsigned int buffer);
+    void bindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+    void bindFramebuffer(unsigned int fbo);
+    void enableBlend(bool enabled);
+    void blendFunc(unsigned int src, unsigned int dst);
+
+    void deleteProgram(unsigned int program);
+    void deleteVertexArray(unsigned int vao);
+    void deleteBuffer(unsigned int buffer);
+    void deleteTexture(unsigned int texture);
+    void deleteFramebuffer(unsigned int fbo);
+
+    // Forget everything cached, e.g. after GL calls made outside this layer
+    void invalidate();
+
+    const Counters& counters();
+    void resetCounters();
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+#include <ostream>
+
+// Display-less GL for build servers: a GL 3.3 core context on EGL's surfaceless
+// platform (Mesa llvmpipe works without a GPU). The app renders into an FBO instead
+// of a window; frames can be read back and written out as PPM images. Built with
+// EGL only (HAVE_EGL); elsewhere createContext() fails.
+namespace Headless {
+    bool createContext();  // makes the context current and loads the GL entry points
+    void destroyContext();
+
+    // Reads the bound framebuffer (bottom-up GL rows) and writes it top-down as binary PPM
+    bool writeFrame(const char* path, int width, int height);
+}
+
+// Per-frame timings of a headless run
+class FrameStats {
+public:
+    void add(double ms) { samples.push_back(ms); }
+    int count() const { return (int)samples.size(); }
+    void report(std::ostream& out) const; // mean, percentiles and worst frame
+
+private:
+    std::vector<double> samples;
+};
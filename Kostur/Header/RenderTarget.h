@@ -0,0 +1,21 @@
+#pragma once
+
+// Offscreen color target: a framebuffer with one RGBA8 texture attached.
+class RenderTarget {
+public:
+    bool create(int width, int height);
+    void destroy();
+    void bind() const;          // render into this target
+    static void bindDefault();  // back to the window framebuffer
+    // Redirects bindDefault() to another framebuffer, e.g. the frame target of a headless run
+    static void setDefault(unsigned int framebuffer);
+
+    unsigned int texture() const { return colorTex; }
+    unsigned int framebuffer() const { return fbo; }
+    int width() const { return w; }
+    int height() const { return h; }
+
+private:
+    unsigned int fbo = 0, colorTex = 0;
+    int w = 0, h = 0;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Where buyNSeats() puts a group
+enum class SeatPolicy {
+    BackRightmost, // last row first, right-most block in it (the original rule)
+    Center         // row nearest the middle, block nearest the middle of that row
+};
+
+// Index of free seats for group allocation. Every row has a segment tree whose nodes
+// hold the free run touching their left edge, their right edge and the longest run
+// inside; a second tree over rows holds each row's longest run. Finding a block of n
+// and updating one seat are both O(log rows + log cols), however large the hall.
+class SeatAllocator {
+public:
+    void init(int rows, int cols); // all seats free
+    void setFree(int row, int col, bool free);
+
+    // First block of n free seats under the policy; false if no row has room
+    bool find(int n, SeatPolicy policy, int& row, int& col) const;
+
+private:
+    struct Run { uint32_t prefix, suffix, best; };
+
+    int rows = 0, cols = 0;
+    int colLeaves = 1, rowLeaves = 1; // leaf counts, powers of two
+    std::vector<Run> runs;            // per row: 2 * colLeaves nodes, root at 1
+    std::vector<uint32_t> rowBest;    // 2 * rowLeaves nodes, max of the rows' longest runs
+
+    Run* rowTree(int row) { return &runs[(size_t)row * 2 * colLeaves]; }
+    const Run* rowTree(int row) const { return &runs[(size_t)row * 2 * colLeaves]; }
+    void pull(Run* t, int node, uint32_t len);
+    void updateRow(int row);
+
+    int lastRowWithRun(int node, int lo, int hi, int maxRow, uint32_t n) const;
+    int firstRowWithRun(int node, int lo, int hi, int minRow, uint32_t n) const;
+    int lastBlock(const Run* t, int node, int lo, int hi, int maxCol, uint32_t n, uint32_t& carry) const;
+    int firstBlock(const Run* t, int node, int lo, int hi, int minCol, uint32_t n, uint32_t& carry) const;
+    int closestBlock(int row, int n) const;
+};
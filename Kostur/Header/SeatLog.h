@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One seat transition, 8 bytes on disk
+struct SeatLogRecord {
+    enum : uint8_t { SET = 0, RESET = 1 }; // RESET: every reserved/bought seat becomes free
+    uint32_t seat;
+    uint8_t type;
+    uint8_t state;
+    uint16_t reserved;
+};
+
+// Append-only write-ahead log of seat state changes. The render thread only queues
+// records; a writer thread collects whatever arrived within a short window and writes
+// it as one checksummed batch followed by a single fdatasync (group commit), so a
+// click never waits for the disk. On startup the log is replayed; a torn batch at
+// the end (crash mid-write) fails its checksum and is cut off. Once a snapshot
+// covers a prefix of the log, trim() drops that prefix so replay stays short.
+// A batch that cannot be written is cut off the file again and retried; if that
+// keeps failing, or the log cannot be reopened after a trim, it goes into a failed
+// state and takes no more records, so durableLsn() never covers a record that is
+// not on disk.
+class SeatLog {
+public:
+    SeatLog() = default;
+    SeatLog(const SeatLog&) = delete;
+    SeatLog& operator=(const SeatLog&) = delete;
+    ~SeatLog() { close(); }
+
+    // Calls apply for every record after skipLsn, in order; lastLsn receives the
+    // number of the last intact record. False only if the file cannot be read.
+    static bool replay(const char* path, uint64_t skipLsn,
+                       const std::function<void(const SeatLogRecord&)>& apply, uint64_t& lastLsn);
+
+    bool open(const char* path, uint64_t lastLsn); // appends after lastLsn, starts the writer
+    void close();                                  // writes what is queued, stops the writer
+    bool isOpen() const { return fd >= 0; }
+    bool failed() const { return broken.load(std::memory_order_acquire); }
+
+    void logState(int seat, uint8_t state);
+    void logReset();
+    void trim(uint64_t lsn); // records up to lsn are no longer needed (any thread)
+
+    uint64_t appendedLsn() const { return nextLsn - 1; }                               // last queued
+    uint64_t durableLsn() const { return durable.load(std::memory_order_acquire); }  // last synced
+    unsigned long long syncs() const { return syncCount.load(std::memory_order_relaxed); }
+    unsigned long long trims() const { return trimCount.load(std::memory_order_relaxed); }
+
+private:
+    void append(const SeatLogRecord& r);
+    void writerLoop();
+    void cutBefore(uint64_t lsn);
+    bool writeBatch(const std::vector<uint8_t>& buffer);
+    void stopLogging(const std::string& why);
+
+    struct WrittenBatch {
+        uint64_t lastLsn;
+        uint64_t offset;
+    };
+
+    int fd = -1;
+    std::string path;
+    uint64_t nextLsn = 1;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::vector<SeatLogRecord> queued;
+    uint64_t queuedFirstLsn = 1;
+    uint64_t trimLsn = 0;
+    bool stopping = false;
+    std::thread writer;
+    std::vector<WrittenBatch> written; // writer thread only
+    uint64_t fileEnd = 0;              // writer thread only
+    std::atomic<uint64_t> durable{ 0 };
+    std::atomic<bool> broken{ false };
+    std::atomic<unsigned long long> syncCount{ 0 };
+    std::atomic<unsigned long long> trimCount{ 0 };
+};
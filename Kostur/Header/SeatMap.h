@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct SeatRect { float x, y, w, h; };
+
+// Seats stored as parallel arrays. The state array (one byte per seat: 0 free,
+// 1 reserved, 2 bought, 3 empty slot in the layout) is all the booking code touches,
+// so scans over it stay in cache and vectorize; rects live apart and row/col follow
+// from the index (seats are numbered row by row). Rects are either owned (resize +
+// setRect) or borrowed from a mapped venue file (attach); rect() applies the map's
+// scale and offset on the way out.
+class SeatMap {
+public:
+    SeatMap() = default;
+    SeatMap(const SeatMap&) = delete; // rect pointers may point into our own storage
+    SeatMap& operator=(const SeatMap&) = delete;
+    SeatMap(SeatMap&&) = default;
+    SeatMap& operator=(SeatMap&&) = default;
+
+    void resize(int rows, int cols); // every seat free, rects zeroed and owned
+    // resize, then lay the seats out as a grid over area: a seat takes 3/4 of its
+    // column and half of its row, gaps spread evenly. The pitch (seat plus gap) is
+    // what a GridPicker needs.
+    void resizeGrid(int rows, int cols, const SeatRect& area, float* pitchX = nullptr, float* pitchY = nullptr);
+    void attach(int rows, int cols, const float* x, const float* y, const float* w, const float* h,
+                const uint8_t* initialStates); // rects used in place, states copied
+    void setTransform(float scale, float offsetX, float offsetY);
+
+    int size() const { return (int)states.size(); }
+    int rows() const { return nRows; }
+    int cols() const { return nCols; }
+    int row(int i) const { return i / nCols; }
+    int col(int i) const { return i % nCols; }
+    int index(int row, int col) const { return row * nCols + col; }
+
+    uint8_t state(int i) const { return states[i]; }
+    void setState(int i, uint8_t s) { states[i] = s; }
+    const uint8_t* stateData() const { return states.data(); }
+
+    SeatRect rect(int i) const {
+        return { xs[i] * scale + offX, ys[i] * scale + offY, ws[i] * scale, hs[i] * scale };
+    }
+    void setRect(int i, const SeatRect& r); // owned rects only
+
+private:
+    int nRows = 0, nCols = 0;
+    std::vector<uint8_t> states;
+    std::vector<float> owned; // x, y, w, h arrays back to back when not attached
+    const float* xs = nullptr;
+    const float* ys = nullptr;
+    const float* ws = nullptr;
+    const float* hs = nullptr;
+    float scale = 1.0f, offX = 0.0f, offY = 0.0f;
+};
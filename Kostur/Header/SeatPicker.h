@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include "SeatMap.h"
+
+// Hit-test index over the seat rects, built once when the layout is set up.
+// Points are in the same (GL, y-up) space as the rects; rect edges count as inside.
+class SeatPicker {
+public:
+    virtual ~SeatPicker() = default;
+    virtual int pick(float x, float y) const = 0; // seat index, -1 if none
+};
+
+// Uniform grid (setupSeats): the cell is computed from the pitch, then one rect test
+class GridPicker : public SeatPicker {
+public:
+    GridPicker(const SeatMap& seats, float originX, float originY, float pitchX, float pitchY);
+    int pick(float x, float y) const override;
+
+private:
+    const SeatMap& seats;
+    float originX, originY, pitchX, pitchY;
+};
+
+// Irregular layouts (venue files): seats bucketed into uniform bins sized from the
+// average seat, stored flat (bin start offsets + seat list). A lookup reads one bin.
+class BinPicker : public SeatPicker {
+public:
+    explicit BinPicker(const SeatMap& seats);
+    int pick(float x, float y) const override;
+
+private:
+    const SeatMap& seats;
+    float minX = 0, minY = 0, maxX = 0, maxY = 0, binW = 1, binH = 1;
+    int binsX = 0, binsY = 0;
+    std::vector<int> binStart; // binsX * binsY + 1 offsets into binSeats
+    std::vector<int> binSeats;
+};
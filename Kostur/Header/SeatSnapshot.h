@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+const uint32_t SNAPSHOT_VERSION = 1;
+const uint32_t SNAPSHOT_ALIGN = 4096; // header page, data and file size are multiples of it (O_DIRECT / mmap)
+
+// Checkpoint of the seat states: 2 bits per seat (0 free, 1 reserved, 2 bought,
+// 3 empty slot), four seats per byte, every row starting on a byte of its own so
+// a row can be read or copied without the others. The header takes the first
+// page and is followed by rows * rowBytes of packed states.
+struct SnapshotHeader {
+    char magic[4];       // "SEAT"
+    uint32_t version;    // SNAPSHOT_VERSION
+    uint32_t rows, cols;
+    uint32_t rowBytes;   // (cols + 3) / 4
+    uint32_t reserved;
+    uint64_t lsn;        // last seat log record the snapshot includes
+    uint64_t dataOffset; // SNAPSHOT_ALIGN
+    uint64_t dataSize;   // rows * rowBytes
+    uint32_t dataCrc;
+    uint32_t headerCrc;  // of this header with headerCrc = 0
+    uint32_t padding[2];
+};
+
+struct SeatSnapshot {
+    uint32_t rows = 0, cols = 0;
+    uint64_t lsn = 0;
+    std::vector<uint8_t> states; // one byte per seat, row-major
+};
+
+// Writes to path + ".tmp", syncs it and renames it over path
+bool writeSnapshot(const char* path, const uint8_t* states, uint32_t rows, uint32_t cols, uint64_t lsn);
+// False if the file is missing or fails validation (the reason goes to stderr)
+bool loadSnapshot(const char* path, SeatSnapshot& out);
+
+// Writes snapshots on its own thread. request() copies the state array (one byte
+// per seat, a memcpy) and returns; packing, checksumming and the fsync happen on
+// the worker. A request made while a snapshot is still being written is refused,
+// the caller simply tries again later.
+class Checkpointer {
+public:
+    Checkpointer() = default;
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+    ~Checkpointer() { stop(); }
+
+    void start(const char* path);
+    void stop();
+    bool running() const { return worker.joinable(); }
+
+    bool request(const uint8_t* states, uint32_t rows, uint32_t cols, uint64_t lsn);
+    bool busy() const { return pending.load(std::memory_order_acquire); }
+    uint64_t completedLsn() const { return completed.load(std::memory_order_acquire); } // last durable snapshot
+    unsigned long long written() const { return writtenCount.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    std::string path;
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::vector<uint8_t> staged;
+    uint32_t stagedRows = 0, stagedCols = 0;
+    uint64_t stagedLsn = 0;
+    std::atomic<bool> pending{ false };
+    std::atomic<uint64_t> completed{ 0 };
+    std::atomic<unsigned long long> writtenCount{ 0 };
+};
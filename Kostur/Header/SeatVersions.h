@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SeatVersions;
+
+// Immutable seat states of one published version; the version stays alive as long
+// as the view does. Views pin a reader slot, so keep them short (a frame, a report)
+// and have at most SeatVersions::MAX_READERS of them at once. A view taken while
+// every slot was in use is not valid() and has no states.
+class SeatView {
+public:
+    SeatView(SeatView&& other) noexcept;
+    SeatView& operator=(SeatView&&) = delete;
+    SeatView(const SeatView&) = delete;
+    ~SeatView();
+
+    bool valid() const { return slot != nullptr; }
+    uint64_t version() const { return ver->number; }
+    int rows() const { return ver->rows; }
+    int cols() const { return ver->cols; }
+    int size() const { return ver->rows * ver->cols; }
+    uint8_t state(int seat) const { return ver->chunks[seat / ver->chunkSeats]->states[seat % ver->chunkSeats]; }
+    const uint8_t* row(int r) const { // cols() bytes; a row never straddles two chunks
+        return ver->chunks[r / ver->rowsPerChunk]->states + (size_t)(r % ver->rowsPerChunk) * ver->cols;
+    }
+
+private:
+    friend class SeatVersions;
+    struct Chunk {
+        uint32_t refs;   // versions holding it
+        uint8_t* states; // rowsPerChunk rows, right behind the chunk in its allocation
+    };
+    struct Version {
+        uint64_t number;
+        int rows, cols, rowsPerChunk, chunkSeats;
+        Chunk** chunks; // right behind the version in its allocation
+    };
+    struct alignas(64) Slot {
+        std::atomic<bool> taken{ false };
+        std::atomic<uint64_t> pinned{ 0 }; // epoch when the view was taken, 0 if idle
+    };
+    SeatView(const Version* v, Slot* s) : ver(v), slot(s) {}
+
+    const Version* ver;
+    Slot* slot;
+};
+
+// Versioned seat states for readers on other threads (rendering, reports, export)
+// while the booking thread keeps changing them. States are kept in chunks of whole
+// rows; a version is a table of chunk pointers published through an atomic pointer.
+// The writer copies a chunk the first time it changes a seat in it after a publish,
+// so a version shares every untouched chunk with the previous one.
+//
+// Readers never lock: read() pins the current epoch in a slot and loads the version.
+// A replaced version is freed by the writer once no slot is pinned at or before the
+// epoch it was replaced in (epoch-based reclamation). A reader that keeps its view
+// for MAX_RETIRED versions holds publishing back until it lets go.
+class SeatVersions {
+public:
+    static const int MAX_READERS = 64;     // views alive at the same time
+    static const size_t MAX_RETIRED = 1024; // replaced versions kept for readers
+
+    SeatVersions() = default;
+    SeatVersions(const SeatVersions&) = delete;
+    SeatVersions& operator=(const SeatVersions&) = delete;
+    ~SeatVersions(); // no views may be left
+
+    // Publishes version 1; before any reader exists
+    void init(int rows, int cols, const uint8_t* states);
+
+    // Writer (one thread): changes go into the next version until publish()
+    void set(int seat, uint8_t state);
+    uint64_t publish(); // the version now current; nothing happens if nothing was set
+
+    // Any thread; gives up (an invalid view) after a few passes over busy slots
+    SeatView read() const;
+
+    uint64_t published() const { return number; }
+    unsigned long long copiedChunks() const { return copies; }
+    int chunkCount() const { return (int)work.size(); }
+    size_t chunkBytes() const { return (size_t)rowsPerChunk * nCols; }
+    size_t retiredVersions() const { return retired.size(); } // waiting for readers
+
+private:
+    using Chunk = SeatView::Chunk;
+    using Version = SeatView::Version;
+    struct Retired { Version* version; uint64_t epoch; };
+
+    Chunk* newChunk();
+    void release(Version* v);
+    void reclaim();
+
+    int nRows = 0, nCols = 0, rowsPerChunk = 1;
+    std::vector<Chunk*> work;         // chunks of the next version
+    std::vector<unsigned char> owned; // work[i] was copied since the last publish
+    bool changed = false;
+    uint64_t number = 0;
+    unsigned long long copies = 0;
+    std::vector<Retired> retired;
+    bool held = false; // publishing paused at MAX_RETIRED
+
+    std::atomic<Version*> current{ nullptr };
+    std::atomic<uint64_t> epoch{ 1 };
+    mutable SeatView::Slot slots[MAX_READERS];
+};
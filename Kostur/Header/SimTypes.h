@@ -0,0 +1,12 @@
+#pragma once
+
+// Shared by the crowd simulations (Theater, Cinema); layout space, y up
+struct Point { float x, y; };
+struct Color { float r, g, b, a; };
+
+namespace Sim {
+    constexpr float WALK_SPEED = 200.0f;    // entering, units/s
+    constexpr float EXIT_SPEED = 220.0f;    // leaving, units/s
+    constexpr float SIM_DT = 1.0f / 120.0f; // simulation tick
+    constexpr float FILM_TIME = 20.0f;      // seconds
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BookingEngine.h"
+#include "SeatAllocator.h"
+#include "SeatLog.h"
+#include "SeatMap.h"
+#include "SeatPicker.h"
+#include "SeatSnapshot.h"
+#include "SeatVersions.h"
+#include "SimTypes.h"
+#include "TimerWheel.h"
+
+class VenueFile;
+
+struct Person {
+    Point pos;
+    Point prevPos;     // pos at the previous simulation tick, for render interpolation
+    Point target;      // current overall movement target (used for exiting)
+    int seatIndex;
+    bool seated;
+    bool exiting;
+    bool reachedRow;
+    Point rowTarget;   // intermediate: same X as entrance, Y of row
+    Point finalTarget; // center of seat
+};
+
+// One hall: seat layout, bookings and the audience simulation. No GL, no windowing
+// and no globals, so a process can run any number of them (the window, headless
+// runs, benchmarks, servers). Coordinates are layout space, y up, 0..width x 0..height
+// (what the app's orthographic projection maps to the screen).
+//
+// Bookings are made on the BookingEngine (from any thread); seats() mirrors it and is
+// brought up to date by syncBookings(), which every booking call here and update() do.
+class Theater {
+public:
+    static constexpr float WALK_SPEED = Sim::WALK_SPEED;
+    static constexpr float EXIT_SPEED = Sim::EXIT_SPEED;
+    static constexpr float SIM_DT = Sim::SIM_DT;
+    static constexpr double HOLD_TTL = 120.0;   // reservations lapse after this many seconds
+
+    // Default 6x9 grid, or the venue's layout scaled into the same area. The venue
+    // must stay open as long as the theater exists (rects are read from the mapping).
+    Theater(int width, int height, const VenueFile* venue = nullptr);
+    Theater(int width, int height, int rows, int cols); // grid of any size, same area
+    Theater(const Theater&) = delete; // the picker and the engine refer to our seats
+    Theater& operator=(const Theater&) = delete;
+    ~Theater();
+
+    int width() const { return w; }
+    int height() const { return h; }
+    const SeatMap& seats() const { return seatMap; }
+    const std::vector<SeatRect>& aisles() const { return aisleRects; }
+    Point entrance() const { return entrancePos; }
+    int seatAt(float x, float y) const { return picker->pick(x, y); } // -1 if none
+
+    // Seat states as of the last sync, safe to read from any thread while bookings go
+    // on (seats().state() belongs to the thread that books and updates). Check valid():
+    // with every reader slot taken there are no states to read.
+    SeatView seatView() const { return versions.read(); }
+    const SeatVersions& seatVersions() const { return versions; }
+
+    // Booking
+    BookingEngine& booking() { return *engine; }
+    void toggleSeat(int idx);
+    bool buyNSeats(int n); // n adjacent free seats placed by seatPolicy()
+    SeatPolicy seatPolicy() const { return policy; }
+    void setSeatPolicy(SeatPolicy p) { policy = p; engine->setBlockPolicy(p); } // clients get it too
+    void syncBookings();
+    size_t pendingHolds() const { return holdTimers.pending(); } // hold timers not due yet, stale ones included
+
+    // Durability: loads path.snap, replays the log at path after it and keeps
+    // appending; checkpoints are written in the background from update()
+    bool openLog(const char* path);
+    void closeLog();
+    const SeatLog& log() const { return seatLog; }
+    const Checkpointer& checkpoints() const { return checkpointer; }
+
+    // Advances the booking clock (hold expiry, checkpoints) and the simulation by
+    // elapsed seconds of wall time; the simulation runs in fixed SIM_DT ticks
+    void update(double elapsed);
+
+    // Audience: people walk in to the booked seats, the film plays, they leave and
+    // the hall is reset. seed 0 picks a random audience.
+    void setSeed(unsigned int s) { seed = s; }
+    void startSimulation();
+    bool simulationRunning() const { return running; }
+    const std::vector<Person>& people() const { return crowd; }
+    Color filmColor() const { return film; }
+    float renderAlpha() const { return alpha; } // how far between the last two ticks to draw
+
+    // Analytic crowd: positions are not stepped, whoever draws the people evaluates
+    // their paths at crowdTime() (the app does it in crowd.vert). Only the phase
+    // boundaries are tracked here.
+    void setAnalyticCrowd(bool on) { analyticCrowd = on; }
+    bool isAnalyticCrowd() const { return analyticCrowd; }
+    unsigned crowdVersion() const { return crowdGeneration; } // changes with every new audience
+    float crowdTime() const;
+    float exitTime() const { return exitAt; } // -1 until the film ends
+
+    // Seats whose state changed since clearDirtySeats(), for incremental redraws
+    const std::vector<int>& dirtySeats() const { return dirty; }
+    void clearDirtySeats();
+
+private:
+    void setupGridSeats(int rows, int cols);
+    void setupVenueSeats(const VenueFile& venue);
+    void setupBookings();
+    void applySeatState(int idx, int state);
+    void pullChanges(bool log);
+    void resetSeats();
+    void expireHolds();
+    void checkpoint();
+    void endSimulation();
+    void randomizeFilmColor();
+    void updateCrowdClock(float dt);
+    void updateSimulation(float dt);
+
+    int w, h;
+    SeatMap seatMap;
+    std::vector<SeatRect> aisleRects;
+    Point entrancePos = { 0.0f, 0.0f };
+    std::unique_ptr<SeatPicker> picker;
+
+    std::unique_ptr<BookingEngine> engine;
+    std::vector<int> changedSeats, lockedSeats;
+    SeatAllocator freeSeats; // mirrors seats().state(i) == 0
+    SeatPolicy policy = SeatPolicy::BackRightmost;
+    std::vector<int> block;
+
+    // Each reservation schedules a timer tagged with the seat's hold generation; any
+    // later change of the seat bumps the generation, so a stale timer is ignored
+    double bookingClock = 0.0;
+    TimerWheel holdTimers;
+    std::vector<uint32_t> holdGen;
+    std::vector<TimerWheel::Expired> expiredHolds;
+
+    SeatLog seatLog;
+    Checkpointer checkpointer;
+    uint64_t checkpointedLsn = 0, trimmedLsn = 0;
+
+    SeatVersions versions; // published at the end of every sync
+    std::vector<int> dirty;
+    std::vector<unsigned char> isDirty;
+
+    unsigned int seed = 0;
+    std::vector<Person> crowd;
+    unsigned crowdGeneration = 0;
+    bool running = false;
+    bool analyticCrowd = true;
+    float filmTime = Sim::FILM_TIME;
+    float filmTimer = 0.0f;
+    float colorTimer = 0.0f; // film time since the last color change
+    Color film = { 0.05f, 0.05f, 0.2f, 1.0f };
+    float simAccumulator = 0.0f;
+    float alpha = 1.0f;
+    float simTime = 0.0f;      // seconds since startSimulation()
+    float seatedTime = 0.0f;   // when the last person reaches their seat
+    float exitAt = -1.0f;      // when people leave their seats
+    float exitDuration = 0.0f; // longest walk from a seat back to the entrance
+};
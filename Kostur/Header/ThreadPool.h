@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. run() cuts [0, count) into
+// chunks of grain that the workers and the calling thread claim until none are left,
+// and returns once all of them are done. No allocation per call.
+class ThreadPool {
+public:
+    explicit ThreadPool(int workerCount); // threads besides the caller; 0 runs everything inline
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    int size() const { return (int)workers.size() + 1; } // counting the caller
+
+    // body(begin, end) for every chunk; body must be safe to call from several threads
+    template<class F> void run(int count, int grain, F& body) {
+        dispatch(count, grain, [](void* f, int begin, int end) { (*static_cast<F*>(f))(begin, end); }, &body);
+    }
+
+private:
+    using Chunk = void (*)(void*, int, int);
+    void dispatch(int count, int grain, Chunk fn, void* ctx);
+    void drain(); // claims chunks of the current job until none are left
+    void work();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, finished;
+    uint64_t generation = 0; // bumped for every job
+    int running = 0;         // workers still inside the current job
+    bool quit = false;
+
+    Chunk chunk = nullptr;
+    void* context = nullptr;
+    int total = 0, step = 1;
+    std::atomic<int> next{ 0 };
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timer wheel: 4 levels of 64 slots, level l spanning 64^l ticks per
+// slot (about 16.7M ticks in total; later expiries wait in the top level and are
+// re-filed as it turns). Scheduling is O(1); each tick fires one level-0 slot and,
+// every 64^l ticks, spreads one level-l slot down a level, so cost depends on the
+// timers due rather than on how many are pending. Timers cannot be cancelled:
+// callers tag them and ignore stale ones when they fire. Nodes are pooled.
+class TimerWheel {
+public:
+    struct Expired { uint32_t id, tag; };
+
+    TimerWheel();
+    uint64_t now() const { return current; }
+    void schedule(uint64_t expiryTick, uint32_t id, uint32_t tag);
+
+    // Moves time forward to tick, appending every timer that is due
+    void advance(uint64_t tick, std::vector<Expired>& out);
+
+    size_t pending() const { return pendingCount; }
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    struct Node { uint64_t expiry; uint32_t id, tag; int next; };
+
+    void insert(int node);
+    int detach(int level, int slot);
+    void release(int node);
+
+    uint64_t current = 0;
+    int heads[LEVELS][SLOTS];
+    std::vector<Node> nodes;
+    int freeList = -1;
+    size_t pendingCount = 0;
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Venue layouts. Halls are authored as text and compiled into a versioned binary
+// that is memory-mapped and used in place: the seat rects are read straight from
+// the mapping, nothing is parsed at startup.
+//
+// Text form, one directive per line ('#' starts a comment):
+//   venue W H               extent of the layout space (scaled to fit the window)
+//   entrance X Y            where people come in and leave
+//   aisle X Y W H           walkway, drawn under the seats
+//   row Y H                 starts a new row at height Y, seats H tall
+//   seats X W PITCH COUNT   COUNT seats of width W from X, every PITCH units
+//   seat X Y W H            one seat with its own rect (curved or staggered rows)
+//   gap COUNT               COUNT empty slots, e.g. where an aisle cuts the row
+// Rows shorter than the longest one are padded with empty slots, so seat
+// (row, col) is always slot row * cols + col.
+
+const uint32_t VENUE_VERSION = 1;
+
+// Binary form: this header, then float arrays x[], y[], w[], h[] of rows * cols
+// slots, a uint8 per slot (0 seat, 3 empty slot) and aisleCount rects of 4 floats.
+// Sections start on 64-byte boundaries.
+struct VenueHeader {
+    char magic[4];           // "VENU"
+    uint32_t version;        // VENUE_VERSION
+    uint32_t rows, cols;
+    float width, height;
+    float entranceX, entranceY;
+    uint32_t aisleCount;
+    uint32_t reserved;
+    uint64_t rectsOffset;
+    uint64_t slotsOffset;
+    uint64_t aislesOffset;
+    uint64_t fileSize;
+};
+
+// Compiles the text form; reports problems with their line number on stderr
+bool compileVenue(const char* textPath, const char* binaryPath);
+
+// A compiled venue mapped read-only
+class VenueFile {
+public:
+    VenueFile() = default;
+    VenueFile(const VenueFile&) = delete;
+    VenueFile& operator=(const VenueFile&) = delete;
+    ~VenueFile() { close(); }
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const VenueHeader& header() const { return *(const VenueHeader*)data; }
+    int slots() const { return (int)(header().rows * header().cols); }
+    const float* xs() const { return rects(); }
+    const float* ys() const { return rects() + slots(); }
+    const float* ws() const { return rects() + 2 * slots(); }
+    const float* hs() const { return rects() + 3 * slots(); }
+    const uint8_t* slotStates() const { return data + header().slotsOffset; }
+    const float* aisles() const { return (const float*)(data + header().aislesOffset); } // x, y, w, h each
+
+private:
+    const float* rects() const { return (const float*)(data + header().rectsOffset); }
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -1,7 +1,9 @@
 #include "Shader.h"
+#include "Header/GLState.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <cstring>
 
 static void checkCompileErrors(unsigned int shader, const std::string& type) {
     int success;
@@ -50,12 +52,45 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    unsigned int camera = glGetUniformBlockIndex(ID, "Camera");
+    if (camera != GL_INVALID_INDEX) glUniformBlockBinding(ID, camera, CAMERA_UBO_BINDING);
+
+    cacheUniforms();
+}
+
+void Shader::cacheUniforms() {
+    int count = 0, maxLen = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
+    std::vector<char> buf(maxLen + 1);
+    for (int i = 0; i < count; ++i) {
+        int len = 0, size = 0;
+        GLenum type;
+        glGetActiveUniform(ID, (GLuint)i, (GLsizei)buf.size(), &len, &size, &type, buf.data());
+        std::string name(buf.data(), len);
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) name.resize(name.size() - 3);
+        int location = glGetUniformLocation(ID, name.c_str());
+        if (location < 0) continue; // member of a uniform block
+        uniforms.push_back({ name, location });
+    }
+}
+
+int Shader::uniform(const char* name) const {
+    for (const UniformInfo& u : uniforms)
+        if (std::strcmp(u.name.c_str(), name) == 0) return u.location;
+    return -1;
 }
 
-Shader::~Shader() { glDeleteProgram(ID); }
-void Shader::use() const { glUseProgram(ID); }
-void Shader::setBool(const std::string& name, bool value) const { glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value); }
-void Shader::setInt(const std::string& name, int value) const { glUniform1i(glGetUniformLocation(ID, name.c_str()), value); }
-void Shader::setFloat(const std::string& name, float value) const { glUniform1f(glGetUniformLocation(ID, name.c_str()), value); }
-void Shader::setVec4(const std::string& name, float x, float y, float z, float w) const { glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w); }
-void Shader::setMat4(const std::string& name, const float* mat) const { glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, mat); }
+Shader::~Shader() { GLState::deleteProgram(ID); }
+void Shader::use() const { GLState::useProgram(ID); }
+void Shader::setBool(const char* name, bool value) const { setBool(uniform(name), value); }
+void Shader::setInt(const char* name, int value) const { setInt(uniform(name), value); }
+void Shader::setFloat(const char* name, float value) const { setFloat(uniform(name), value); }
+void Shader::setVec4(const char* name, float x, float y, float z, float w) const { setVec4(uniform(name), x, y, z, w); }
+void Shader::setMat4(const char* name, const float* mat) const { setMat4(uniform(name), mat); }
+void Shader::setBool(int location, bool value) const { glUniform1i(location, (int)value); }
+void Shader::setInt(int location, int value) const { glUniform1i(location, value); }
+void Shader::setFloat(int location, float value) const { glUniform1f(location, value); }
+void Shader::setVec4(int location, float x, float y, float z, float w) const { glUniform4f(location, x, y, z, w); }
+void Shader::setMat4(int location, const float* mat) const { glUniformMatrix4fv(location, 1, GL_FALSE, mat); }
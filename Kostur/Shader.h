@@ -1,17 +1,38 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+// Uniform buffer binding of the shared "Camera" block (projection + view).
+// Every shader that declares the block is bound to it at link time.
+const unsigned int CAMERA_UBO_BINDING = 0;
+
 class Shader {
 public:
     unsigned int ID;
     Shader(const char* vertexPath, const char* fragmentPath);
     ~Shader();
     void use() const;
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec4(const std::string& name, float x, float y, float z, float w) const;
-    void setMat4(const std::string& name, const float* mat) const;
+
+    // Location of an active uniform, read once from the linked program (-1 if absent)
+    int uniform(const char* name) const;
+
+    void setBool(const char* name, bool value) const;
+    void setInt(const char* name, int value) const;
+    void setFloat(const char* name, float value) const;
+    void setVec4(const char* name, float x, float y, float z, float w) const;
+    void setMat4(const char* name, const float* mat) const;
+
+    // Handle based setters, for callers that keep the location from uniform()
+    void setBool(int location, bool value) const;
+    void setInt(int location, int value) const;
+    void setFloat(int location, float value) const;
+    void setVec4(int location, float x, float y, float z, float w) const;
+    void setMat4(int location, const float* mat) const;
+
+private:
+    struct UniformInfo { std::string name; int location; };
+    std::vector<UniformInfo> uniforms;
+    void cacheUniforms();
 };
@@ -0,0 +1,4 @@
+#version 330 core
+out vec2 vTex;
+// fullscreen triangle generated from gl_VertexID, no vertex buffer needed
+void main(){ vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2); vTex = p; gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0); }
@@ -0,0 +1,35 @@
+#version 330 core
+layout(location=0) in vec2 aPos;   // unit quad corner
+layout(location=2) in vec4 iRoute; // entrance.xy, row waypoint.xy
+layout(location=3) in vec4 iSeat;  // seat.xy, walking speed, start time
+out vec4 vColor;
+layout(std140) uniform Camera { mat4 uProj; mat4 uView; };
+uniform float uTime;      // seconds since the simulation started
+uniform float uExitTime;  // when everybody leaves, negative while the film runs
+uniform float uExitSpeed;
+
+vec2 walk(vec2 from, vec2 to, float dist){
+    float len = length(to - from);
+    return len > 0.0 ? from + (to - from) * min(dist / len, 1.0) : to;
+}
+
+void main(){
+    vec2 entrance = iRoute.xy, waypoint = iRoute.zw, seat = iSeat.xy;
+    vec2 pos;
+    if (uExitTime >= 0.0 && uTime >= uExitTime) {
+        pos = walk(seat, entrance, (uTime - uExitTime) * uExitSpeed);
+    } else {
+        // down the aisle to the row, then along the row to the seat
+        float dist = max(uTime - iSeat.w, 0.0) * iSeat.z;
+        float leg = length(waypoint - entrance);
+        pos = dist < leg ? walk(entrance, waypoint, dist) : walk(waypoint, seat, dist - leg);
+    }
+
+    // two instances per person (the path attributes advance every second instance):
+    // even instances draw the body, odd ones the head
+    float head = float(gl_InstanceID % 2);
+    vec2 offset = mix(vec2(-8.0, -12.0), vec2(-6.0, 12.0), head);
+    vec2 size = mix(vec2(16.0, 24.0), vec2(12.0, 12.0), head);
+    vColor = mix(vec4(0.2, 0.8, 0.2, 1.0), vec4(1.0, 0.8, 0.6, 1.0), head);
+    gl_Position = uProj * uView * vec4(pos + offset + aPos * size, 0.0, 1.0);
+}
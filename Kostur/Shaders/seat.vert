@@ -0,0 +1,7 @@
+#version 330 core
+layout(location=0) in vec2 aPos;
+layout(location=2) in vec4 iRect;  // x, y, w, h
+layout(location=3) in vec4 iColor;
+out vec4 vColor;
+layout(std140) uniform Camera { mat4 uProj; mat4 uView; };
+void main(){ vColor = iColor; gl_Position = uProj * uView * vec4(iRect.xy + aPos * iRect.zw, 0.0, 1.0); }
@@ -0,0 +1,135 @@
+#include "../Header/BookingEngine.h"
+#include <cstdlib>
+#include <random>
+#include <thread>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static int lowestBit(uint64_t v) {
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward64(&idx, v);
+    return (int)idx;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+BookingEngine::BookingEngine(int r, int c, const uint8_t* initialStates)
+    : rows(r), cols(c),
+      seats(new std::atomic<uint8_t>[(size_t)r * c]),
+      changed(new std::atomic<uint64_t>[((size_t)r * c + 63) / 64]) {
+    for (int i = 0; i < size(); ++i) seats[i].store(initialStates ? initialStates[i] : (uint8_t)SEAT_FREE, std::memory_order_relaxed);
+    for (int w = 0; w < (size() + 63) / 64; ++w) changed[w].store(0, std::memory_order_relaxed);
+}
+
+void BookingEngine::markChanged(int seat) {
+    changed[seat / 64].fetch_or(1ull << (seat % 64), std::memory_order_release);
+}
+
+bool BookingEngine::transition(int seat, uint8_t from, uint8_t to) {
+    uint8_t expected = from;
+    if (!seats[seat].compare_exchange_strong(expected, to, std::memory_order_acq_rel)) return false;
+    markChanged(seat);
+    return true;
+}
+
+bool BookingEngine::reserve(int seat) { return transition(seat, SEAT_FREE, SEAT_RESERVED); }
+
+bool BookingEngine::release(int seat) { return transition(seat, SEAT_RESERVED, SEAT_FREE); }
+
+bool BookingEngine::buy(int seat) {
+    return transition(seat, SEAT_FREE, SEAT_BOUGHT) || transition(seat, SEAT_RESERVED, SEAT_BOUGHT);
+}
+
+bool BookingEngine::cancel(int seat) {
+    return transition(seat, SEAT_RESERVED, SEAT_FREE) || transition(seat, SEAT_BOUGHT, SEAT_FREE);
+}
+
+bool BookingEngine::toggle(int seat) { return reserve(seat) || release(seat); }
+
+bool BookingEngine::acquire(const int* list, int n, uint8_t to) {
+    // lock first, publish after: no other acquire can take a seat of the group, but a
+    // reader may catch it half published, some seats bought and the rest still locked
+    for (int k = 0; k < n; ++k) {
+        uint8_t expected = SEAT_FREE;
+        if (!seats[list[k]].compare_exchange_strong(expected, SEAT_LOCKED, std::memory_order_acq_rel)) {
+            for (int j = 0; j < k; ++j) seats[list[j]].store(SEAT_FREE, std::memory_order_release);
+            conflictCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    for (int k = 0; k < n; ++k) {
+        seats[list[k]].store(to, std::memory_order_release);
+        markChanged(list[k]);
+    }
+    return true;
+}
+
+// Start column of the block of n free seats nearest the middle of the row, the left
+// one on a tie; -1 if none
+int BookingEngine::centerBlock(int row, int n) const {
+    int best = -1, ideal = (cols - n) / 2, run = 0;
+    for (int c = 0; c < cols; ++c) {
+        run = state(row * cols + c) == SEAT_FREE ? run + 1 : 0;
+        if (run < n) continue;
+        int start = c - n + 1;
+        if (best < 0 || std::abs(start - ideal) < std::abs(best - ideal)) best = start;
+    }
+    return best;
+}
+
+// Same placement as SeatAllocator::find by a plain scan over the atomics; the
+// allocator's index is single-threaded
+int BookingEngine::findBlock(int n, SeatPolicy policy) const {
+    if (policy == SeatPolicy::BackRightmost) {
+        for (int r = rows - 1; r >= 0; --r) {
+            int run = 0;
+            for (int c = cols - 1; c >= 0; --c) {
+                run = state(r * cols + c) == SEAT_FREE ? run + 1 : 0;
+                if (run == n) return r * cols + c;
+            }
+        }
+        return -1;
+    }
+    // rows nearest the middle first (distances doubled to stay integral), upper one on a tie
+    int row = -1, col = -1, bestDistance = 0;
+    for (int r = 0; r < rows; ++r) {
+        int distance = std::abs(2 * r - (rows - 1));
+        if (row >= 0 && distance > bestDistance) continue;
+        int c = centerBlock(r, n);
+        if (c >= 0) { row = r; col = c; bestDistance = distance; }
+    }
+    return row < 0 ? -1 : row * cols + col;
+}
+
+int BookingEngine::buyBlock(int n, SeatPolicy policy) {
+    if (n <= 0 || n > cols) return -1;
+    thread_local std::minstd_rand rng(std::random_device{}());
+    std::vector<int> list(n);
+    for (int attempt = 0; ; ++attempt) {
+        int first = findBlock(n, policy);
+        if (first < 0) return -1;
+        for (int k = 0; k < n; ++k) list[k] = first + k;
+        if (acquire(list.data(), n, SEAT_BOUGHT)) return first;
+
+        // lost a race for part of the block: back off for a random, growing while
+        int limit = 1 << std::min(attempt, 10);
+        int spins = (int)(rng() % (unsigned)limit);
+        for (int s = 0; s < spins; ++s) std::this_thread::yield();
+    }
+}
+
+void BookingEngine::reset() {
+    for (int i = 0; i < size(); ++i)
+        if (!transition(i, SEAT_RESERVED, SEAT_FREE)) transition(i, SEAT_BOUGHT, SEAT_FREE);
+}
+
+void BookingEngine::collectChanges(std::vector<int>& out) {
+    for (int w = 0; w < (size() + 63) / 64; ++w) {
+        if (changed[w].load(std::memory_order_relaxed) == 0) continue;
+        uint64_t bits = changed[w].exchange(0, std::memory_order_acq_rel);
+        for (; bits; bits &= bits - 1) out.push_back(w * 64 + lowestBit(bits));
+    }
+}
@@ -0,0 +1,80 @@
+#include "../Header/BookingProtocol.h"
+
+namespace BookingProtocol {
+
+namespace {
+    void put16(std::vector<uint8_t>& out, uint16_t v) { size_t n = out.size(); out.resize(n + 2); std::memcpy(&out[n], &v, 2); }
+    void put32(std::vector<uint8_t>& out, uint32_t v) { size_t n = out.size(); out.resize(n + 4); std::memcpy(&out[n], &v, 4); }
+}
+
+long decodeFrame(const uint8_t* data, size_t size, FrameView& frame) {
+    if (size < 4) return 0;
+    uint32_t frameSize = read32(data);
+    if (frameSize < FRAME_HEADER || frameSize > MAX_FRAME) return -1;
+    if (size < frameSize) return 0;
+    if (read16(data + 10) != 0) return -1;
+
+    // every op has to fit and the ops have to fill the frame exactly
+    uint16_t ops = read16(data + 8);
+    const uint8_t* p = data + FRAME_HEADER;
+    const uint8_t* end = data + frameSize;
+    for (uint16_t i = 0; i < ops; ++i) {
+        if ((size_t)(end - p) < OP_HEADER || p[1] != 0) return -1;
+        size_t seats = 4 * (size_t)read16(p + 2);
+        if ((size_t)(end - p) - OP_HEADER < seats) return -1;
+        p += OP_HEADER + seats;
+    }
+    if (p != end) return -1;
+
+    frame.id = read32(data + 4);
+    frame.ops = ops;
+    frame.cursor = data + FRAME_HEADER;
+    return (long)frameSize;
+}
+
+void FrameWriter::begin(uint32_t id) {
+    start = out.size();
+    ops = 0;
+    put32(out, 0);
+    put32(out, id);
+    put16(out, 0);
+    put16(out, 0);
+}
+
+void FrameWriter::op(Code code, uint32_t arg, const uint32_t* seats, uint16_t count) {
+    out.push_back(code);
+    out.push_back(0);
+    put16(out, count);
+    put32(out, arg);
+    for (uint16_t i = 0; i < count; ++i) put32(out, seats[i]);
+    ++ops;
+}
+
+void FrameWriter::end() {
+    uint32_t size = (uint32_t)(out.size() - start);
+    std::memcpy(&out[start], &size, 4);
+    std::memcpy(&out[start + 8], &ops, 2);
+}
+
+void beginReply(std::vector<uint8_t>& out, uint32_t id, uint16_t ops) {
+    put32(out, 0);
+    put32(out, id);
+    put16(out, ops);
+    put16(out, 0);
+}
+
+void result(std::vector<uint8_t>& out, uint8_t code, Status status, uint16_t count, int32_t value) {
+    size_t n = out.size();
+    out.resize(n + RESULT_HEADER);
+    out[n] = code;
+    out[n + 1] = status;
+    std::memcpy(&out[n + 2], &count, 2);
+    std::memcpy(&out[n + 4], &value, 4);
+}
+
+void endReply(std::vector<uint8_t>& out, size_t start) {
+    uint32_t size = (uint32_t)(out.size() - start);
+    std::memcpy(&out[start], &size, 4);
+}
+
+}
@@ -0,0 +1,256 @@
+#include "../Header/BookingServer.h"
+#include "../Header/BookingEngine.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    bool allDigits(const char* s) {
+        if (!*s) return false;
+        for (; *s; ++s) if (*s < '0' || *s > '9') return false;
+        return true;
+    }
+}
+
+bool BookingServer::start(const char* address) {
+    stop();
+    if (allDigits(address)) {
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int yes = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)std::atoi(address));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (listenFd < 0 || bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            std::cerr << "Cannot listen on port " << address << "\n"; stop(); return false;
+        }
+    }
+    else {
+        sockaddr_un addr = {};
+        if (std::strlen(address) >= sizeof(addr.sun_path)) { std::cerr << "Socket path too long\n"; return false; }
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, address);
+        unlink(address); // left over from a previous run
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0 || bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            std::cerr << "Cannot listen on " << address << "\n"; stop(); return false;
+        }
+        socketPath = address;
+    }
+    if (listen(listenFd, 128) != 0) { std::cerr << "listen failed\n"; stop(); return false; }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+    loop = std::thread(&BookingServer::run, this);
+    return true;
+}
+
+void BookingServer::stop() {
+    if (loop.joinable()) {
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) std::cerr << "Cannot wake the booking server\n";
+        loop.join();
+    }
+    for (auto& c : connections) if (c) close(c->fd);
+    connections.clear();
+    if (listenFd >= 0) close(listenFd);
+    if (epollFd >= 0) close(epollFd);
+    if (wakeFd >= 0) close(wakeFd);
+    listenFd = epollFd = wakeFd = -1;
+    if (!socketPath.empty()) unlink(socketPath.c_str());
+    socketPath.clear();
+}
+
+void BookingServer::run() {
+    epoll_event events[64];
+    for (;;) {
+        int n = epoll_wait(epollFd, events, 64, -1);
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) return;
+            if (fd == listenFd) { accept(); continue; }
+            Connection* c = fd < (int)connections.size() ? connections[fd].get() : nullptr;
+            if (!c) continue;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) { drop(fd); continue; }
+            if (events[i].events & EPOLLOUT && !flush(*c)) { drop(fd); continue; }
+            if (events[i].events & EPOLLIN && c->reading) receive(*c);
+        }
+    }
+}
+
+void BookingServer::accept() {
+    for (;;) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return; // EAGAIN: nothing more to accept
+        int yes = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes)); // fails harmlessly on Unix sockets
+        if (fd >= (int)connections.size()) connections.resize(fd + 1);
+        connections[fd].reset(new Connection(fd));
+        connections[fd]->in.resize(2 * BookingProtocol::MAX_FRAME);
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    }
+}
+
+void BookingServer::receive(Connection& c) {
+    ssize_t n = read(c.fd, c.in.data() + c.received, c.in.size() - c.received);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) { drop(c.fd); return; }
+    if (n < 0) return;
+    c.received += (size_t)n;
+
+    // every complete frame is answered; the replies go out with one write
+    long used = process(c.in.data(), c.received, c.out);
+    if (used < 0) { drop(c.fd); return; }
+    c.received -= (size_t)used;
+    if (c.received && used) std::memmove(c.in.data(), c.in.data() + used, c.received); // start of the next frame
+    if ((!c.writing || c.out.size() > MAX_PENDING) && !flush(c)) drop(c.fd);
+}
+
+// Writes what it can; the rest waits for EPOLLOUT. Reading pauses while too much
+// is left, so replies nobody reads cannot pile up. False when the peer is gone.
+bool BookingServer::flush(Connection& c) {
+    size_t sent = 0;
+    while (sent < c.out.size()) {
+        ssize_t w = write(c.fd, c.out.data() + sent, c.out.size() - sent);
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0 && errno == EAGAIN) break;
+        if (w <= 0) return false;
+        sent += (size_t)w;
+    }
+    c.out.erase(c.out.begin(), c.out.begin() + sent);
+    bool pending = !c.out.empty();
+    bool room = c.out.size() <= MAX_PENDING;
+    if (pending != c.writing || room != c.reading) {
+        c.writing = pending;
+        c.reading = room;
+        epoll_event ev = {};
+        ev.events = (room ? (uint32_t)EPOLLIN : 0u) | (pending ? (uint32_t)EPOLLOUT : 0u);
+        ev.data.fd = c.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+    }
+    return true;
+}
+
+void BookingServer::drop(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections[fd].reset();
+}
+
+#else
+
+bool BookingServer::start(const char*) {
+    std::cerr << "The booking server needs Linux (epoll)\n";
+    return false;
+}
+
+void BookingServer::stop() {}
+
+#endif
+
+void BookingServer::setOpen(bool open) {
+    bookingOpen.store(open);
+    if (open) return;
+    while (inFlight.load(std::memory_order_acquire)) std::this_thread::yield();
+}
+
+long BookingServer::process(const uint8_t* data, size_t size, std::vector<uint8_t>& reply) {
+    using namespace BookingProtocol;
+    size_t used = 0;
+    FrameView frame;
+    for (;;) {
+        long n = decodeFrame(data + used, size - used, frame);
+        if (n < 0) return -1;
+        if (n == 0) return (long)used;
+        size_t start = reply.size();
+        beginReply(reply, frame.id, frame.ops);
+        OpView op;
+        for (uint16_t i = 0; i < frame.ops; ++i) {
+            frame.next(op);
+            execute(op, reply);
+        }
+        endReply(reply, start);
+        used += (size_t)n;
+    }
+}
+
+void BookingServer::execute(const BookingProtocol::OpView& op, std::vector<uint8_t>& reply) {
+    using namespace BookingProtocol;
+    requestCount.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < op.count; ++i)
+        if (op.seat(i) >= (uint32_t)engine.size()) { result(reply, op.code, BAD, 0, 0); return; }
+
+    if (op.code == QUERY) {
+        result(reply, QUERY, OK, op.count, op.count);
+        size_t n = reply.size();
+        reply.resize(n + (op.count + 3) / 4 * 4, 0);
+        for (int i = 0; i < op.count; ++i) {
+            uint8_t state = engine.state((int)op.seat(i));
+            reply[n + i] = state == SEAT_LOCKED ? (uint8_t)SEAT_FREE : state; // not taken until the group is
+        }
+        return;
+    }
+    // counted before the check, so setOpen(false) can wait for whoever got past it
+    inFlight.fetch_add(1);
+    if (!bookingOpen.load()) {
+        inFlight.fetch_sub(1, std::memory_order_release);
+        result(reply, op.code, CLOSED, op.count, 0);
+        return;
+    }
+    book(op, reply);
+    inFlight.fetch_sub(1, std::memory_order_release);
+}
+
+void BookingServer::book(const BookingProtocol::OpView& op, std::vector<uint8_t>& reply) {
+    using namespace BookingProtocol;
+    switch (op.code) {
+    case RESERVE:
+    case BUY: {
+        if (op.count == 0) break;
+        bool ok;
+        if (op.count == 1) ok = op.code == BUY ? engine.buy((int)op.seat(0)) : engine.reserve((int)op.seat(0));
+        else {
+            group.resize(op.count);
+            for (int i = 0; i < op.count; ++i) group[i] = (int)op.seat(i);
+            ok = engine.acquire(group.data(), op.count, op.code == BUY ? SEAT_BOUGHT : SEAT_RESERVED);
+        }
+        result(reply, op.code, ok ? OK : NO, op.count, ok ? op.count : 0);
+        return;
+    }
+    case CANCEL:
+    case TOGGLE: {
+        int done = 0;
+        for (int i = 0; i < op.count; ++i)
+            done += op.code == CANCEL ? engine.cancel((int)op.seat(i)) : engine.toggle((int)op.seat(i));
+        result(reply, op.code, done == op.count ? OK : NO, op.count, done);
+        return;
+    }
+    case BEST: {
+        if (op.count != 0) break;
+        int first = op.arg <= (uint32_t)engine.colCount() ? engine.buyBlock((int)op.arg, engine.blockPolicy()) : -1;
+        result(reply, BEST, first >= 0 ? OK : NO, 0, first);
+        return;
+    }
+    }
+    result(reply, op.code, BAD, 0, 0);
+}
@@ -0,0 +1,310 @@
+#include "../Header/Cinema.h"
+#include "../Header/Arena.h"
+#include "../Header/BookingEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+
+namespace {
+    const float MAX_FRAME_DT = 0.25f;
+    const int SHOWS_PER_CHUNK = 8; // shows a worker claims at once
+
+    // Where a person is headed: up or down to the seat's row (keeping the entrance x),
+    // along it to the seat, then straight back to the entrance
+    enum : uint8_t { TO_ROW, TO_SEAT, SEATED, LEAVING, OUT };
+
+    // Walks (x, y) toward (tx, ty); true (and snapped onto it) once within 2 units
+    bool stepTowards(float& x, float& y, float tx, float ty, float speed, float dt) {
+        float dx = tx - x, dy = ty - y;
+        float dist = std::sqrt(dx * dx + dy * dy);
+        if (dist < 2.0f) { x = tx; y = ty; return true; }
+        float step = speed * dt / dist;
+        x += dx * step;
+        y += dy * step;
+        return false;
+    }
+
+    // Start of the block of n free seats in a row the policy prefers, -1 if none
+    int blockInRow(const uint8_t* row, int cols, int n, SeatPolicy policy) {
+        int best = -1, ideal = (cols - n) / 2, run = 0;
+        for (int c = 0; c < cols; ++c) {
+            run = row[c] == SEAT_FREE ? run + 1 : 0;
+            if (run < n) continue;
+            int start = c - n + 1;
+            if (policy == SeatPolicy::BackRightmost || best < 0 || std::abs(start - ideal) < std::abs(best - ideal)) best = start;
+        }
+        return best;
+    }
+}
+
+struct Cinema::Hall {
+    int rows, cols, seats;
+    std::vector<float> cx, cy;    // seat centers
+    std::vector<uint8_t> initial; // SEAT_FREE, or SEAT_EMPTY where the layout has no seat
+    Point entrance;
+    size_t blockSize;
+    void* spare = nullptr;        // blocks of destroyed shows, each holding the next one's address
+};
+
+// Head of a show's block; the arrays follow it in the same block
+struct Cinema::Show {
+    const Hall* hall;
+    int id;
+    int runningSlot; // index in running, -1 when not running
+    ShowPhase phase;
+    int people;
+    float filmTimer;
+    uint8_t* states; // per seat
+    int32_t* seat;   // per person (before the show: booked seats to draw the audience from)
+    float* x;
+    float* y;
+    uint8_t* leg;
+};
+
+Cinema::Cinema(int threads)
+    : pool((threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency())) - 1) {}
+
+Cinema::~Cinema() {
+    for (Show* s : shows) std::free(s);
+    for (auto& h : halls)
+        while (void* block = h->spare) { h->spare = *static_cast<void**>(block); std::free(block); }
+}
+
+Cinema::Show* Cinema::carve(Arena& arena, int seats) {
+    Show* s = arena.alloc<Show>(1);
+    uint8_t* states = arena.alloc<uint8_t>(seats);
+    int32_t* seat = arena.alloc<int32_t>(seats);
+    float* x = arena.alloc<float>(seats);
+    float* y = arena.alloc<float>(seats);
+    uint8_t* leg = arena.alloc<uint8_t>(seats);
+    if (!s) return nullptr;
+    s = new (s) Show();
+    s->states = states; s->seat = seat; s->x = x; s->y = y; s->leg = leg;
+    return s;
+}
+
+int Cinema::addHall(const SeatMap& layout, Point entrance) {
+    std::unique_ptr<Hall> h(new Hall());
+    h->rows = layout.rows();
+    h->cols = layout.cols();
+    h->seats = layout.size();
+    h->cx.resize(h->seats);
+    h->cy.resize(h->seats);
+    h->initial.resize(h->seats);
+    for (int i = 0; i < h->seats; ++i) {
+        SeatRect r = layout.rect(i);
+        h->cx[i] = r.x + r.w * 0.5f;
+        h->cy[i] = r.y + r.h * 0.5f;
+        h->initial[i] = layout.state(i) == SEAT_EMPTY ? SEAT_EMPTY : SEAT_FREE;
+    }
+    h->entrance = entrance;
+    Arena measure(nullptr, SIZE_MAX);
+    carve(measure, h->seats);
+    h->blockSize = measure.used();
+    halls.push_back(std::move(h));
+    return (int)halls.size() - 1;
+}
+
+int Cinema::hallSeats(int hall) const { return hall >= 0 && hall < hallCount() ? halls[hall]->seats : -1; }
+size_t Cinema::showBytes(int hall) const { return hall >= 0 && hall < hallCount() ? halls[hall]->blockSize : 0; }
+
+Cinema::Show* Cinema::find(int show) const {
+    return show >= 0 && show < (int)shows.size() ? shows[show] : nullptr;
+}
+
+int Cinema::createShow(int hall) {
+    if (hall < 0 || hall >= hallCount()) return -1;
+    Hall& h = *halls[hall];
+    void* block;
+    if (h.spare) { block = h.spare; h.spare = *static_cast<void**>(block); }
+    else {
+        block = std::malloc(h.blockSize);
+        if (!block) return -1;
+        ++allocatedBlocks;
+    }
+    Arena arena(block, h.blockSize);
+    Show* s = carve(arena, h.seats);
+    s->hall = &h;
+    s->runningSlot = -1;
+    s->phase = ShowPhase::Selling;
+    s->people = 0;
+    s->filmTimer = 0.0f;
+    std::memcpy(s->states, h.initial.data(), h.seats);
+
+    if (!freeIds.empty()) { s->id = freeIds.back(); freeIds.pop_back(); shows[s->id] = s; }
+    else { s->id = (int)shows.size(); shows.push_back(s); }
+    ++liveShows;
+    return s->id;
+}
+
+void Cinema::destroyShow(int show) {
+    Show* s = find(show);
+    if (!s) return;
+    if (s->runningSlot >= 0) stop(*s);
+    Hall& h = *const_cast<Hall*>(s->hall);
+    *reinterpret_cast<void**>(s) = h.spare; // the show heads its block
+    h.spare = s;
+    shows[show] = nullptr;
+    freeIds.push_back(show);
+    --liveShows;
+}
+
+bool Cinema::toggleSeat(int show, int seat) {
+    Show* found = find(show);
+    if (!found) return false;
+    Show& s = *found;
+    if (s.phase != ShowPhase::Selling || seat < 0 || seat >= s.hall->seats) return false;
+    uint8_t& state = s.states[seat];
+    if (state == SEAT_FREE) state = SEAT_RESERVED;
+    else if (state == SEAT_RESERVED) state = SEAT_FREE;
+    else return false;
+    return true;
+}
+
+// Same placement as SeatAllocator::find, by scanning the seat bytes: a show keeps no
+// index besides them, and a row is a few dozen bytes
+bool Cinema::buyNSeats(int show, int n, SeatPolicy policy) {
+    Show* found = find(show);
+    if (!found) return false;
+    Show& s = *found;
+    const Hall& h = *s.hall;
+    if (s.phase != ShowPhase::Selling || n <= 0 || n > h.cols) return false;
+
+    int row = -1, col = -1;
+    if (policy == SeatPolicy::BackRightmost) {
+        for (int r = h.rows - 1; r >= 0 && row < 0; --r)
+            if ((col = blockInRow(s.states + (size_t)r * h.cols, h.cols, n, policy)) >= 0) row = r;
+    }
+    else {
+        // rows nearest the middle first (distances doubled to stay integral), upper one on a tie
+        int bestDistance = 0;
+        for (int r = 0; r < h.rows; ++r) {
+            int distance = std::abs(2 * r - (h.rows - 1));
+            if (row >= 0 && distance > bestDistance) continue;
+            int c = blockInRow(s.states + (size_t)r * h.cols, h.cols, n, policy);
+            if (c >= 0) { row = r; col = c; bestDistance = distance; }
+        }
+    }
+    if (row < 0) return false;
+    std::memset(s.states + (size_t)row * h.cols + col, SEAT_BOUGHT, n);
+    return true;
+}
+
+uint8_t Cinema::seatState(int show, int seat) const {
+    const Show* s = find(show);
+    return s && seat >= 0 && seat < s->hall->seats ? s->states[seat] : (uint8_t)SEAT_EMPTY;
+}
+
+int Cinema::freeSeats(int show) const {
+    const Show* found = find(show);
+    if (!found) return -1;
+    const Show& s = *found;
+    return (int)std::count(s.states, s.states + s.hall->seats, (uint8_t)SEAT_FREE);
+}
+
+void Cinema::startShow(int show, unsigned int seed) {
+    Show* found = find(show);
+    if (!found) return;
+    Show& s = *found;
+    const Hall& h = *s.hall;
+    if (s.phase != ShowPhase::Selling) return;
+    int booked = 0;
+    for (int i = 0; i < h.seats; ++i)
+        if (s.states[i] == SEAT_RESERVED || s.states[i] == SEAT_BOUGHT) s.seat[booked++] = i;
+    if (booked == 0) return;
+
+    std::random_device rd;
+    std::mt19937 g(seed ? seed : rd());
+    std::shuffle(s.seat, s.seat + booked, g);
+    s.people = std::uniform_int_distribution<int>(1, booked)(g);
+    for (int i = 0; i < s.people; ++i) {
+        s.x[i] = h.entrance.x;
+        s.y[i] = h.entrance.y;
+        s.leg[i] = TO_ROW;
+    }
+    s.phase = ShowPhase::Entering;
+    s.filmTimer = 0.0f;
+    s.runningSlot = (int)running.size();
+    running.push_back(&s);
+}
+
+ShowPhase Cinema::phase(int show) const {
+    const Show* s = find(show);
+    return s ? s->phase : ShowPhase::Over;
+}
+
+int Cinema::audience(int show) const {
+    const Show* s = find(show);
+    return s ? s->people : -1;
+}
+
+Point Cinema::personAt(int show, int person) const {
+    const Show* s = find(show);
+    if (!s || person < 0 || person >= s->people) return { 0.0f, 0.0f };
+    return { s->x[person], s->y[person] };
+}
+
+void Cinema::stop(Show& s) {
+    Show* last = running.back();
+    running[s.runningSlot] = last;
+    last->runningSlot = s.runningSlot;
+    running.pop_back();
+    s.runningSlot = -1;
+}
+
+// Same phases as Theater's stepped crowd
+void Cinema::step(Show& s, float dt, int ticks) {
+    const Hall& h = *s.hall;
+    for (int t = 0; t < ticks && s.phase != ShowPhase::Over; ++t) {
+        if (s.phase == ShowPhase::Entering) {
+            bool allSeated = true;
+            for (int i = 0; i < s.people; ++i) {
+                uint8_t& leg = s.leg[i];
+                if (leg == SEATED) continue;
+                allSeated = false;
+                int seat = s.seat[i];
+                if (leg == TO_ROW) { if (stepTowards(s.x[i], s.y[i], h.entrance.x, h.cy[seat], Sim::WALK_SPEED, dt)) leg = TO_SEAT; }
+                else if (stepTowards(s.x[i], s.y[i], h.cx[seat], h.cy[seat], Sim::WALK_SPEED, dt)) leg = SEATED;
+            }
+            if (allSeated) s.phase = ShowPhase::Playing;
+        }
+        else if (s.phase == ShowPhase::Playing) {
+            s.filmTimer += dt;
+            if (s.filmTimer >= Sim::FILM_TIME) {
+                s.phase = ShowPhase::Leaving;
+                std::fill(s.leg, s.leg + s.people, (uint8_t)LEAVING);
+            }
+        }
+        else {
+            bool allGone = true;
+            for (int i = 0; i < s.people; ++i) {
+                if (s.leg[i] == OUT) continue;
+                if (stepTowards(s.x[i], s.y[i], h.entrance.x, h.entrance.y, Sim::EXIT_SPEED, dt)) s.leg[i] = OUT;
+                else allGone = false;
+            }
+            if (allGone) s.phase = ShowPhase::Over;
+        }
+    }
+}
+
+void Cinema::update(double elapsed) {
+    accumulator += std::min((float)elapsed, MAX_FRAME_DT);
+    int ticks = (int)(accumulator / Sim::SIM_DT);
+    accumulator -= ticks * Sim::SIM_DT;
+    if (ticks == 0 || running.empty()) return;
+
+    // every show is independent, so workers take chunks of the running list
+    auto body = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) step(*running[i], Sim::SIM_DT, ticks);
+    };
+    pool.run((int)running.size(), SHOWS_PER_CHUNK, body);
+
+    for (size_t i = 0; i < running.size();) {
+        if (running[i]->phase == ShowPhase::Over) stop(*running[i]);
+        else ++i;
+    }
+}
@@ -0,0 +1,77 @@
+#include "../Header/DrawList.h"
+#include "../Shader.h"
+#include "../Header/GLState.h"
+
+void DrawList::init() {
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    GLState::bindVertexArray(vao);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(2 * sizeof(float)));
+    GLState::bindVertexArray(0);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void DrawList::destroy() {
+    if (vao) GLState::deleteVertexArray(vao);
+    if (vbo) GLState::deleteBuffer(vbo);
+    vao = vbo = 0;
+    capacity = 0;
+}
+
+void DrawList::begin() {
+    verts.clear();
+    cmds.clear();
+}
+
+void DrawList::quad(float x, float y, float w, float h, const glm::vec4& color) {
+    int first = (int)verts.size();
+    Vertex v0 = { x,     y,     color.r, color.g, color.b, color.a };
+    Vertex v1 = { x + w, y,     color.r, color.g, color.b, color.a };
+    Vertex v2 = { x + w, y + h, color.r, color.g, color.b, color.a };
+    Vertex v3 = { x,     y + h, color.r, color.g, color.b, color.a };
+    verts.push_back(v0); verts.push_back(v1); verts.push_back(v2);
+    verts.push_back(v2); verts.push_back(v3); verts.push_back(v0);
+
+    // extend the current batch if it ends right here, otherwise open a new one
+    if (!cmds.empty() && !cmds.back().fn && cmds.back().first + cmds.back().count == first)
+        cmds.back().count += 6;
+    else
+        cmds.push_back({ first, 6, nullptr });
+}
+
+void DrawList::custom(std::function<void()> fn) {
+    cmds.push_back({ 0, 0, std::move(fn) });
+}
+
+void DrawList::submit(const Shader& shader) {
+    lastDrawCalls = 0;
+    if (!verts.empty()) {
+        size_t bytes = verts.size() * sizeof(Vertex);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, vbo);
+        while (capacity < bytes) capacity = capacity ? capacity * 2 : 64 * 1024;
+        // orphan last frame's storage so the driver never stalls on a buffer still in flight
+        glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, verts.data());
+    }
+
+    bool bound = false;
+    for (const Cmd& c : cmds) {
+        if (c.fn) {
+            c.fn();
+            bound = false; // custom work may switch program / VAO
+            ++lastDrawCalls;
+            continue;
+        }
+        if (!bound) {
+            shader.use();
+            GLState::bindVertexArray(vao);
+            bound = true;
+        }
+        glDrawArrays(GL_TRIANGLES, c.first, c.count);
+        ++lastDrawCalls;
+    }
+}
@@ -0,0 +1,145 @@
+#include "../Header/FileIO.h"
+#include <cstdio>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace FileIO {
+
+#ifdef _WIN32
+int openAppend(const char* path) { return _open(path, _O_WRONLY | _O_CREAT | _O_BINARY | _O_APPEND, _S_IREAD | _S_IWRITE); }
+int openWrite(const char* path) { return _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE); }
+int openRead(const char* path) { return _open(path, _O_RDONLY | _O_BINARY); }
+void close(int fd) { _close(fd); }
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        int chunk = (int)(size < (1u << 30) ? size : (1u << 30));
+        int w = _write(fd, p, (unsigned)chunk);
+        if (w <= 0) return false;
+        p += w; size -= (size_t)w;
+    }
+    return true;
+}
+bool syncData(int fd) { return _commit(fd) == 0; }
+bool readAll(const char* path, std::vector<uint8_t>& out) {
+    int fd = _open(path, _O_RDONLY | _O_BINARY);
+    if (fd < 0) return false;
+    out.clear();
+    uint8_t chunk[1 << 16];
+    for (int n; (n = _read(fd, chunk, sizeof(chunk))) > 0; ) out.insert(out.end(), chunk, chunk + n);
+    _close(fd);
+    return true;
+}
+bool readAt(int fd, uint64_t offset, void* data, size_t size) {
+    if (_lseeki64(fd, (long long)offset, SEEK_SET) != (long long)offset) return false;
+    char* p = (char*)data;
+    while (size > 0) {
+        int chunk = (int)(size < (1u << 30) ? size : (1u << 30));
+        int r = _read(fd, p, (unsigned)chunk);
+        if (r <= 0) return false;
+        p += r; size -= (size_t)r;
+    }
+    return true;
+}
+bool truncate(const char* path, uint64_t size) {
+    int fd = _open(path, _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _chsize_s(fd, (long long)size) == 0;
+    _close(fd);
+    return ok;
+}
+bool truncate(int fd, uint64_t size) {
+    return _chsize_s(fd, (long long)size) == 0 && _lseeki64(fd, (long long)size, SEEK_SET) == (long long)size;
+}
+bool replace(const char* from, const char* to) {
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+bool remove(const char* path) { return _unlink(path) == 0; }
+int64_t fileSize(int fd) {
+    struct _stat64 st;
+    return _fstat64(fd, &st) == 0 ? (int64_t)st.st_size : -1;
+}
+#else
+int openAppend(const char* path) { return ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644); }
+int openWrite(const char* path) { return ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644); }
+int openRead(const char* path) { return ::open(path, O_RDONLY); }
+void close(int fd) { ::close(fd); }
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        ssize_t w = ::write(fd, p, size);
+        if (w <= 0) return false;
+        p += w; size -= (size_t)w;
+    }
+    return true;
+}
+bool syncData(int fd) { return ::fdatasync(fd) == 0; }
+bool readAll(const char* path, std::vector<uint8_t>& out) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    out.clear();
+    uint8_t chunk[1 << 16];
+    for (ssize_t n; (n = ::read(fd, chunk, sizeof(chunk))) > 0; ) out.insert(out.end(), chunk, chunk + n);
+    ::close(fd);
+    return true;
+}
+bool readAt(int fd, uint64_t offset, void* data, size_t size) {
+    char* p = (char*)data;
+    while (size > 0) {
+        ssize_t r = ::pread(fd, p, size, (off_t)offset);
+        if (r <= 0) return false;
+        p += r; size -= (size_t)r; offset += (uint64_t)r;
+    }
+    return true;
+}
+bool truncate(const char* path, uint64_t size) { return ::truncate(path, (off_t)size) == 0; }
+bool truncate(int fd, uint64_t size) {
+    return ::ftruncate(fd, (off_t)size) == 0 && ::lseek(fd, (off_t)size, SEEK_SET) == (off_t)size;
+}
+bool replace(const char* from, const char* to) {
+    if (std::rename(from, to) != 0) return false;
+    // the rename itself is only durable once the directory entry is
+    std::string dir(to);
+    size_t slash = dir.find_last_of('/');
+    dir = slash == std::string::npos ? "." : slash == 0 ? "/" : dir.substr(0, slash);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+bool remove(const char* path) { return ::unlink(path) == 0; }
+int64_t fileSize(int fd) {
+    struct stat st;
+    return ::fstat(fd, &st) == 0 ? (int64_t)st.st_size : -1;
+}
+#endif
+
+uint32_t crc32(const void* data, size_t size, uint32_t crc) {
+    static const struct Table {
+        uint32_t v[256];
+        Table() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                v[i] = c;
+            }
+        }
+    } table;
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = table.v[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+}
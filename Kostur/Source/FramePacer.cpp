@@ -0,0 +1,34 @@
+#include "../Header/FramePacer.h"
+#include <thread>
+
+void FramePacer::start(double fps, bool vsync) {
+    period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    useVsync = vsync;
+    lastFrame = Clock::now();
+    deadline = lastFrame;
+    frameCount = missed = 0;
+}
+
+void FramePacer::wait() {
+    ++frameCount;
+    if (useVsync) {
+        // the swap paced us; a gap of more than 1.5 periods means a refresh was skipped
+        Clock::time_point now = Clock::now();
+        if (now - lastFrame > period + period / 2) ++missed;
+        lastFrame = now;
+        return;
+    }
+
+    deadline += period;
+    Clock::time_point now = Clock::now();
+    if (now >= deadline) {
+        ++missed;
+        // more than a whole frame behind: start over from now instead of rushing to catch up
+        if (now - deadline > period) deadline = now;
+        lastFrame = now;
+        return;
+    }
+    if (deadline - now > spinMargin) std::this_thread::sleep_until(deadline - spinMargin);
+    while (Clock::now() < deadline) std::this_thread::yield();
+    lastFrame = deadline;
+}
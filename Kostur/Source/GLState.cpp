@@ -0,0 +1,132 @@
+#include "../Header/GLState.h"
+#include <glad/glad.h>
+
+namespace {
+    const unsigned int UNKNOWN = 0xFFFFFFFFu;
+    const int MAX_TEXTURE_UNITS = 16;
+
+    // buffer targets we track; anything else is passed straight through
+    enum { ARRAY_SLOT, ELEMENT_SLOT, UNIFORM_SLOT, BUFFER_SLOTS };
+
+    struct Cache {
+        unsigned int program = UNKNOWN;
+        unsigned int vao = UNKNOWN;
+        unsigned int framebuffer = UNKNOWN;
+        unsigned int buffers[BUFFER_SLOTS] = { UNKNOWN, UNKNOWN, UNKNOWN };
+        unsigned int activeUnit = UNKNOWN;
+        unsigned int textures[MAX_TEXTURE_UNITS];
+        int blend = -1; // -1 unknown, 0 off, 1 on
+        unsigned int blendSrc = UNKNOWN, blendDst = UNKNOWN;
+        Cache() { for (unsigned int& t : textures) t = UNKNOWN; }
+    };
+
+    Cache cache;
+    GLState::Counters stats;
+
+    int bufferSlot(unsigned int target) {
+        switch (target) {
+        case GL_ARRAY_BUFFER: return ARRAY_SLOT;
+        case GL_ELEMENT_ARRAY_BUFFER: return ELEMENT_SLOT;
+        case GL_UNIFORM_BUFFER: return UNIFORM_SLOT;
+        default: return -1;
+        }
+    }
+
+    // true when the call must reach GL; updates the cached value and counters
+    bool changes(unsigned int& cached, unsigned int value) {
+        if (cached == value) { ++stats.skipped; return false; }
+        cached = value;
+        ++stats.issued;
+        return true;
+    }
+}
+
+namespace GLState {
+    void useProgram(unsigned int program) {
+        if (changes(cache.program, program)) glUseProgram(program);
+    }
+
+    void bindVertexArray(unsigned int vao) {
+        if (!changes(cache.vao, vao)) return;
+        glBindVertexArray(vao);
+        // the element array binding is part of the VAO
+        cache.buffers[ELEMENT_SLOT] = UNKNOWN;
+    }
+
+    void bindBuffer(unsigned int target, unsigned int buffer) {
+        int slot = bufferSlot(target);
+        if (slot < 0) { ++stats.issued; glBindBuffer(target, buffer); return; }
+        if (changes(cache.buffers[slot], buffer)) glBindBuffer(target, buffer);
+    }
+
+    void bindBufferBase(unsigned int target, unsigned int index, unsigned int buffer) {
+        // indexed bindings are rare (once per resize); always forward, but note the generic binding moved
+        ++stats.issued;
+        glBindBufferBase(target, index, buffer);
+        int slot = bufferSlot(target);
+        if (slot >= 0) cache.buffers[slot] = buffer;
+    }
+
+    void bindTexture(unsigned int unit, unsigned int target, unsigned int texture) {
+        if (target != GL_TEXTURE_2D || unit >= (unsigned int)MAX_TEXTURE_UNITS) {
+            ++stats.issued;
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(target, texture);
+            cache.activeUnit = unit;
+            return;
+        }
+        if (cache.textures[unit] == texture) { ++stats.skipped; return; }
+        if (changes(cache.activeUnit, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+        cache.textures[unit] = texture;
+        ++stats.issued;
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+
+    void bindFramebuffer(unsigned int fbo) {
+        if (changes(cache.framebuffer, fbo)) glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    }
+
+    void enableBlend(bool enabled) {
+        if (cache.blend == (int)enabled) { ++stats.skipped; return; }
+        cache.blend = (int)enabled;
+        ++stats.issued;
+        if (enabled) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+    }
+
+    void blendFunc(unsigned int src, unsigned int dst) {
+        if (cache.blendSrc == src && cache.blendDst == dst) { ++stats.skipped; return; }
+        cache.blendSrc = src; cache.blendDst = dst;
+        ++stats.issued;
+        glBlendFunc(src, dst);
+    }
+
+    void deleteProgram(unsigned int program) {
+        if (cache.program == program) cache.program = UNKNOWN;
+        glDeleteProgram(program);
+    }
+
+    void deleteVertexArray(unsigned int vao) {
+        if (cache.vao == vao) { cache.vao = UNKNOWN; cache.buffers[ELEMENT_SLOT] = UNKNOWN; }
+        glDeleteVertexArrays(1, &vao);
+    }
+
+    void deleteBuffer(unsigned int buffer) {
+        for (unsigned int& b : cache.buffers) if (b == buffer) b = UNKNOWN;
+        glDeleteBuffers(1, &buffer);
+    }
+
+    void deleteTexture(unsigned int texture) {
+        for (unsigned int& t : cache.textures) if (t == texture) t = UNKNOWN;
+        glDeleteTextures(1, &texture);
+    }
+
+    void deleteFramebuffer(unsigned int fbo) {
+        if (cache.framebuffer == fbo) cache.framebuffer = UNKNOWN;
+        glDeleteFramebuffers(1, &fbo);
+    }
+
+    void invalidate() { cache = Cache(); }
+
+    const Counters& counters() { return stats; }
+    void resetCounters() { stats = Counters(); }
+}
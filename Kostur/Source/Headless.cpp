@@ -0,0 +1,111 @@
+#include "../Header/Headless.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+
+#ifdef HAVE_EGL // set by CMake when EGL is found
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace {
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+
+    EGLDisplay openDisplay() {
+        // prefer the surfaceless platform so no X/Wayland server or DRM node is needed
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) {
+            EGLDisplay d = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (d != EGL_NO_DISPLAY) return d;
+        }
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+}
+
+namespace Headless {
+    bool createContext() {
+        display = openDisplay();
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+            std::cerr << "Failed to init EGL\n"; return false;
+        }
+        if (!eglBindAPI(EGL_OPENGL_API)) { std::cerr << "EGL has no desktop OpenGL\n"; return false; }
+
+        // surface type 0: we never create a surface, so window/pbuffer support is irrelevant
+        const EGLint configAttribs[] = { EGL_SURFACE_TYPE, 0, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+        EGLConfig config; EGLint numConfigs = 0;
+        if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs < 1) {
+            std::cerr << "No EGL config for OpenGL\n"; return false;
+        }
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+        // no surface at all: everything is drawn into FBOs
+        if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+            std::cerr << "Failed to create a surfaceless GL 3.3 context\n"; return false;
+        }
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+            std::cerr << "Failed to init GLAD\n"; return false;
+        }
+        return true;
+    }
+
+    void destroyContext() {
+        if (display == EGL_NO_DISPLAY) return;
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+        eglTerminate(display);
+        display = EGL_NO_DISPLAY;
+        context = EGL_NO_CONTEXT;
+    }
+}
+#else
+namespace Headless {
+    bool createContext() { std::cerr << "Headless mode needs EGL, this build has none\n"; return false; }
+    void destroyContext() {}
+}
+#endif
+
+namespace Headless {
+    bool writeFrame(const char* path, int width, int height) {
+        std::vector<unsigned char> rgba((size_t)width * height * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+
+        FILE* f = std::fopen(path, "wb");
+        if (!f) { std::cerr << "Cannot write " << path << "\n"; return false; }
+        std::fprintf(f, "P6\n%d %d\n255\n", width, height);
+        std::vector<unsigned char> row((size_t)width * 3);
+        for (int y = height - 1; y >= 0; --y) {
+            const unsigned char* src = &rgba[(size_t)y * width * 4];
+            for (int x = 0; x < width; ++x) {
+                row[x * 3 + 0] = src[x * 4 + 0];
+                row[x * 3 + 1] = src[x * 4 + 1];
+                row[x * 3 + 2] = src[x * 4 + 2];
+            }
+            std::fwrite(row.data(), 1, row.size(), f);
+        }
+        std::fclose(f);
+        return true;
+    }
+}
+
+void FrameStats::report(std::ostream& out) const {
+    if (samples.empty()) { out << "no frames\n"; return; }
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](double p) { return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))]; };
+    double mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    out << "frames " << sorted.size()
+        << "  mean " << mean << " ms"
+        << "  p50 " << pct(0.50) << " ms"
+        << "  p95 " << pct(0.95) << " ms"
+        << "  p99 " << pct(0.99) << " ms"
+        << "  max " << sorted.back() << " ms"
+        << "  (" << 1000.0 / mean << " fps)\n";
+}
@@ -4,325 +4,339 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <iostream>
+#include <memory>
 #include <vector>
+#include <algorithm>
 #include <chrono>
-#include <thread>
 #include <cmath>
 #include <random>
 #include <ctime>
 #include <cstdlib>
+#include <cstring>
+#include <string>
 
 #include "../Shader.h"
+#include "../Header/DrawList.h"
+#include "../Header/GLState.h"
+#include "../Header/RenderTarget.h"
+#include "../Header/Headless.h"
+#include "../Header/FramePacer.h"
+#include "../Header/Venue.h"
+#include "../Header/Theater.h"
+#include "../Header/BookingServer.h"
 
 // Simple 2D movie theater simulation
 
-struct Seat {
-    int state; // 0 free,1 reserved,2 bought
-    float x, y, w, h;
-    int row, col;
-};
-
-struct Person {
-    glm::vec2 pos;
-    glm::vec2 target;      // current overall movement target (used for exiting)
-    int seatIndex;
-    bool seated;
-    bool exiting;
-    bool reachedRow;
-    glm::vec2 rowTarget;   // intermediate: same X as entrance, Y of row
-    glm::vec2 finalTarget; // center of seat
-};
-
 // Globals
 int SCR_W = 1280;
 int SCR_H = 720;
-const int ROWS = 6;
-const int COLS = 9; // 6x9 = 54 seats, in specification minimal is 50 seats
-std::vector<Seat> seats;
-std::vector<Person> people;
+VenueFile venue; // mapped layout from --venue, seat rects are read from it in place
+std::unique_ptr<Theater> theater; // seats, bookings and the audience; the code below draws it
+std::unique_ptr<BookingServer> bookingServer; // --listen
 
 bool overlay = true; // starts with overlay on
+double cursorX = 0.0, cursorY = 0.0; // window coordinates, top-left origin (as GLFW reports them)
 
 Shader* shader = nullptr;
-unsigned int quadVAO = 0, quadVBO = 0, quadEBO = 0;
+DrawList drawList; // everything but the seats is batched here each frame
+unsigned int unitQuadVBO = 0, unitQuadEBO = 0;
+
+// Instanced seats: one rect + color per seat, drawn with a single call; seats the
+// theater reports dirty get their color re-uploaded
+Shader* seatShader = nullptr;
+unsigned int seatVAO = 0, seatInstanceVBO = 0;
+
+// Static layer: background and seat grid, cached offscreen and
+// only repainted where a seat changed. Each frame composites it under the dynamic layers.
+RenderTarget staticLayer;
+DrawList staticList;
+Shader* blitShader = nullptr;
+unsigned int blitVAO = 0; // empty VAO for the fullscreen triangle in blit.vert
+bool staticLayerDirty = true;
 
 glm::mat4 proj;
+glm::mat4 view = glm::mat4(1.0f);
+unsigned int cameraUBO = 0; // std140 block "Camera" { mat4 uProj; mat4 uView; }
+
+// Uploads proj/view into the shared Camera block; call whenever either changes
+void updateCamera() {
+    if (!cameraUBO) {
+        glGenBuffers(1, &cameraUBO);
+        GLState::bindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+        glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+        GLState::bindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING, cameraUBO);
+    }
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), &proj[0][0]);
+    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), &view[0][0]);
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+}
 
-void initQuad() {
-    // positions and tex coords
-    float verts[] = {
-        // x, y,   u, v
-        0.0f, 0.0f, 0.0f, 0.0f,
-        1.0f, 0.0f, 1.0f, 0.0f,
-        1.0f, 1.0f, 1.0f, 1.0f,
-        0.0f, 1.0f, 0.0f, 1.0f
-    };
+// Unit quad corners and indices shared by the instanced seats and crowd
+void initUnitQuad() {
+    float corners[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
     unsigned int indices[] = { 0,1,2, 2,3,0 };
-    glGenVertexArrays(1, &quadVAO);
-    glGenBuffers(1, &quadVBO);
-    glGenBuffers(1, &quadEBO);
-    glBindVertexArray(quadVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glBindVertexArray(0);
+    glGenBuffers(1, &unitQuadVBO);
+    glGenBuffers(1, &unitQuadEBO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, unitQuadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    // filled through the array target: the element binding belongs to a VAO, and the
+    // VAOs that use it bind it themselves
+    GLState::bindBuffer(GL_ARRAY_BUFFER, unitQuadEBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 }
 
+// Queues a quad into this frame's draw list; nothing is drawn until renderScene() submits it
 void drawQuad(float x, float y, float w, float h, glm::vec4 color) {
-    shader->use();
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, 0.0f));
-    model = glm::scale(model, glm::vec3(w, h, 1.0f));
-    shader->setMat4("uProj", &proj[0][0]);
-    shader->setMat4("uModel", &model[0][0]);
-    shader->setVec4("uColor", color.r, color.g, color.b, color.a);
-    glBindVertexArray(quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    drawList.quad(x, y, w, h, color);
 }
 
-int screenToGLY(double y) { return SCR_H - (int)y; }
-
-void setupSeats() {
-    seats.clear();
-    float marginX = 120.0f;
-    float marginY = 140.0f;
-    float areaW = SCR_W - 2 * marginX;
-    float areaH = SCR_H - 2 * marginY;
-    float seatW = (areaW / (float)COLS) * 0.75f;
-    float seatH = (areaH / (float)ROWS) * 0.5f;
-    float spacingX = (areaW - seatW * COLS) / std::max(1, COLS - 1);
-    float spacingY = (areaH - seatH * ROWS) / std::max(1, ROWS - 1);
-    for (int r = 0; r < ROWS; ++r) {
-        for (int c = 0; c < COLS; ++c) {
-            float x = marginX + c * (seatW + spacingX);
-            float y = marginY + r * (seatH + spacingY);
-            Seat s; s.state = 0; s.x = x; s.y = y; s.w = seatW; s.h = seatH; s.row = r; s.col = c;
-            seats.push_back(s);
-        }
-    }
+glm::vec4 seatColor(int state) {
+    if (state == 1) return glm::vec4(0.9f, 0.9f, 0.2f, 1.0f); // reserved yellow
+    if (state == 2) return glm::vec4(0.9f, 0.2f, 0.2f, 1.0f); // bought red
+    return glm::vec4(0.2f, 0.4f, 0.9f, 1.0f); // free blue
 }
 
-int seatAtPos(double mx, double my) {
-    int myg = screenToGLY(my);
-    for (int i = 0; i < (int)seats.size(); ++i) {
-        Seat& s = seats[i];
-        if (mx >= s.x && mx <= s.x + s.w && myg >= s.y && myg <= s.y + s.h) return i;
+void initSeatInstances() {
+    const SeatMap& seats = theater->seats(); // rects; states come from the published version
+    SeatView view = theater->seatView(); // if every reader slot is taken, the mirror (ours on this thread)
+    // per-instance layout: rect (x, y, w, h) followed by color (r, g, b, a)
+    std::vector<float> data;
+    data.reserve(seats.size() * 8);
+    for (int i = 0; i < seats.size(); ++i) {
+        SeatRect s = seats.rect(i);
+        glm::vec4 c = seatColor(view.valid() ? view.state(i) : seats.state(i));
+        float inst[8] = { s.x, s.y, s.w, s.h, c.r, c.g, c.b, c.a };
+        data.insert(data.end(), inst, inst + 8);
+    }
+    if (!seatVAO) {
+        glGenVertexArrays(1, &seatVAO);
+        glGenBuffers(1, &seatInstanceVBO);
+        GLState::bindVertexArray(seatVAO);
+        // shared unit quad
+        GLState::bindBuffer(GL_ARRAY_BUFFER, unitQuadVBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, unitQuadEBO);
+        // per-seat attributes
+        GLState::bindBuffer(GL_ARRAY_BUFFER, seatInstanceVBO);
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+        glVertexAttribDivisor(2, 1);
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(4 * sizeof(float)));
+        glVertexAttribDivisor(3, 1);
+        GLState::bindVertexArray(0);
     }
-    return -1;
+    GLState::bindBuffer(GL_ARRAY_BUFFER, seatInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_DYNAMIC_DRAW);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    theater->clearDirtySeats();
 }
 
-void toggleSeat(int idx) {
-    if (idx < 0) return;
-    if (seats[idx].state == 0) seats[idx].state = 1;
-    else if (seats[idx].state == 1) seats[idx].state = 0;
+bool startBookingServer(const char* address) {
+    bookingServer.reset(new BookingServer(theater->booking()));
+    if (!bookingServer->start(address)) { bookingServer.reset(); return false; }
+    std::cout << "booking server listening on " << address << "\n";
+    return true;
 }
 
-void buyNSeats(int N) {
-    if (N <= 0 || N > COLS) return; // invalid request or impossible to fit in a row
-
-    // Search rows from last (closest to screen bottom) to first (top)
-    for (int r = ROWS - 1; r >= 0; --r) {
-        // j will be the right-most index of the candidate block
-        for (int j = COLS - 1; j >= 0; --j) {
-            int start = j - (N - 1); // left-most index of block
-            if (start < 0) continue; // block would be out of bounds on the left
-
-            bool ok = true;
-            for (int c = start; c <= j; ++c) {
-                int idx = r * COLS + c;
-                if (seats[idx].state != 0) { // must be FREE (state == 0)
-                    ok = false;
-                    break;
-                }
-            }
-            if (ok) {
-                // Mark the contiguous block as bought
-                for (int c = start; c <= j; ++c) {
-                    int idx = r * COLS + c;
-                    seats[idx].state = 2; // bought
-                }
-                return; // we stop after first block found (per spec)
-            }
-        }
-    }
+// Stops taking requests and brings the seats and the log up to date with the last ones
+void stopBookingServer() {
+    if (!bookingServer) return;
+    bookingServer->stop();
+    std::cout << "booking server: " << bookingServer->requests() << " requests\n";
+    bookingServer.reset();
+    theater->syncBookings();
 }
 
-// Simulation state
-bool simulationRunning = false;
-float filmTime = 20.0f; // seconds
-float filmTimer = 0.0f;
-int frameCounter = 0;
-glm::vec4 filmColor = glm::vec4(0.05f, 0.05f, 0.2f, 1.0f);
-
-// Entrance coordinates (top-left region)
-glm::vec2 entrancePos;
-
-void startSimulation() {
-    people.clear();
-    std::vector<int> seatIndices;
-    for (int i = 0; i < (int)seats.size(); ++i) {
-        if (seats[i].state == 1 || seats[i].state == 2) {
-            seatIndices.push_back(i);
-        }
+void uploadDirtySeats() {
+    const std::vector<int>& dirtySeats = theater->dirtySeats();
+    if (dirtySeats.empty()) return;
+    if ((int)dirtySeats.size() * 4 > theater->seats().size()) {
+        // most of the hall changed (e.g. reset), a full re-upload is cheaper than many small ones
+        initSeatInstances();
+        return;
     }
-    if (seatIndices.empty()) return;
-
-    int totalPossible = (int)seatIndices.size();
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(seatIndices.begin(), seatIndices.end(), g);
-
-    std::uniform_int_distribution<int> distNum(1, totalPossible);
-    int numPeople = distNum(g);
-
-    for (int i = 0; i < numPeople; ++i) {
-        int si = seatIndices[i];
-        Person p;
-        p.seated = false; p.exiting = false; p.seatIndex = si;
-        // entrance at top-left small margin
-        p.pos = entrancePos;
-        Seat& s = seats[si];
-        p.finalTarget = glm::vec2(s.x + s.w * 0.5f, s.y + s.h * 0.5f);
-        // rowTarget: keep entrance X, target Y = row's center (move vertically toward row Y)
-        p.rowTarget = glm::vec2(p.pos.x, p.finalTarget.y);
-        p.reachedRow = false;
-        p.target = p.finalTarget; // not used until exiting
-        people.push_back(p);
+    SeatView view = theater->seatView();
+    if (!view.valid()) return; // every reader slot taken, the seats stay dirty for the next frame
+    GLState::bindBuffer(GL_ARRAY_BUFFER, seatInstanceVBO);
+    for (int idx : dirtySeats) {
+        glm::vec4 c = seatColor(view.state(idx));
+        float color[4] = { c.r, c.g, c.b, c.a };
+        glBufferSubData(GL_ARRAY_BUFFER, (idx * 8 + 4) * sizeof(float), sizeof(color), color);
     }
+    theater->clearDirtySeats();
+}
 
-    if (!people.empty()) {
-        simulationRunning = true;
-        filmTimer = 0.0f;
-        frameCounter = 0;
-        overlay = false;
-    }
+void drawSeats() {
+    uploadDirtySeats();
+    seatShader->use();
+    GLState::bindVertexArray(seatVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, (GLsizei)theater->seats().size());
 }
 
-void updateSimulation(float dt) {
-    if (!simulationRunning) return;
-
-    bool allSeated = true;
-    // Move people toward their seats
-    for (auto& p : people) {
-        if (!p.seated && !p.exiting) {
-            allSeated = false;
-            if (!p.reachedRow) {
-                // move vertically to rowTarget.y (keeping x = entrance.x)
-                glm::vec2 dir = p.rowTarget - p.pos;
-                float dist = glm::length(dir);
-                if (dist < 2.0f) {
-                    p.reachedRow = true;
-                    p.pos = p.rowTarget;
-                }
-                else {
-                    dir = glm::normalize(dir);
-                    p.pos += dir * 200.0f * dt;
-                }
-            }
-            else {
-                // move horizontally (and small vertical correction) to seat finalTarget
-                glm::vec2 dir = p.finalTarget - p.pos;
-                float dist = glm::length(dir);
-                if (dist < 2.0f) {
-                    p.seated = true;
-                    p.pos = p.finalTarget;
-                }
-                else {
-                    dir = glm::normalize(dir);
-                    p.pos += dir * 200.0f * dt;
-                }
-            }
-        }
-    }
+void rebuildStaticLayer() {
+    staticLayer.bind();
+    staticList.begin();
+    // background
+    staticList.quad(0, 0, (float)SCR_W, (float)SCR_H, glm::vec4(0.02f, 0.02f, 0.05f, 1.0f));
+    for (const SeatRect& a : theater->aisles()) staticList.quad(a.x, a.y, a.w, a.h, glm::vec4(0.08f, 0.08f, 0.12f, 1.0f));
+    // seats (single instanced draw)
+    staticList.custom(drawSeats);
+    staticList.submit(*shader);
+    RenderTarget::bindDefault();
+    staticLayerDirty = false;
+}
 
-    // Only if all are seated, run film timer
-    if (allSeated) {
-        filmTimer += dt;
-        frameCounter++;
-        if (frameCounter % 20 == 0) {
-            // randomize color periodically
-            std::random_device rd;
-            std::mt19937 g(rd());
-            std::uniform_real_distribution<float> d(0.1f, 0.7f);
-            filmColor = glm::vec4(d(g), d(g), d(g), 1.0f);
-        }
-        if (filmTimer >= filmTime) {
-            // start exiting: set target to entrance for each person
-            filmColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
-            for (auto& p : people) {
-                p.exiting = true;
-                p.seated = false;
-                p.target = entrancePos;
-                p.reachedRow = false;
-            }
-        }
+void updateStaticLayer() {
+    const SeatMap& seats = theater->seats();
+    const std::vector<int>& dirtySeats = theater->dirtySeats();
+    if ((int)dirtySeats.size() * 4 > seats.size()) staticLayerDirty = true; // e.g. reset, redraw everything
+    if (staticLayerDirty) { rebuildStaticLayer(); return; }
+    if (dirtySeats.empty()) return;
+    // seats are opaque, so repainting a changed seat simply covers its old color
+    SeatView view = theater->seatView();
+    if (!view.valid()) return; // as in uploadDirtySeats
+    staticLayer.bind();
+    staticList.begin();
+    for (int idx : dirtySeats) {
+        SeatRect s = seats.rect(idx);
+        staticList.quad(s.x, s.y, s.w, s.h, seatColor(view.state(idx)));
     }
+    staticList.submit(*shader);
+    RenderTarget::bindDefault();
+    uploadDirtySeats(); // keep the instance buffer in sync for the next full rebuild
+}
 
-    // Handle exiting movement
-    bool allGone = true;
-    for (auto& p : people) {
-        if (p.exiting) {
-            glm::vec2 dir = p.target - p.pos;
-            float dist = glm::length(dir);
-            if (dist < 2.0f) {
-                p.pos = p.target;
-            }
-            else {
-                dir = glm::normalize(dir);
-                p.pos += dir * 220.0f * dt;
-            }
-        }
-        // person is considered gone if above top or at entrance exactly
-        if (!(p.pos == p.target && p.exiting && glm::length(p.pos - p.target) < 0.01f)) {
-            // if any person is still not at target (entrance) or still moving, not all gone
-            if (!(p.exiting && glm::length(p.pos - p.target) < 2.0f)) allGone = false;
-        }
+void compositeStaticLayer() {
+    // the layer is fully opaque, copy it instead of blending
+    GLState::enableBlend(false);
+    blitShader->use();
+    GLState::bindTexture(0, GL_TEXTURE_2D, staticLayer.texture());
+    GLState::bindVertexArray(blitVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    GLState::enableBlend(true);
+}
+
+int screenToGLY(double y) { return SCR_H - (int)y; }
+
+int seatAtPos(double mx, double my) {
+    return theater->seatAt((float)mx, (float)screenToGLY(my));
+}
+
+// GPU crowd: every person is uploaded once as path parameters and crowd.vert
+// evaluates the position from the simulation clock (the theater's analytic crowd),
+// so the per-frame CPU cost no longer depends on the crowd size. With gpuCrowd off
+// the theater steps the people and they are drawn as quads.
+bool gpuCrowd = true;
+Shader* crowdShader = nullptr;
+unsigned int crowdVAO = 0, crowdVBO = 0;
+unsigned uploadedCrowd = 0; // theater->crowdVersion() in crowdVBO
+
+void uploadCrowd() {
+    // per person: entrance.xy, row waypoint.xy | seat.xy, speed, start time
+    const std::vector<Person>& people = theater->people();
+    std::vector<float> data;
+    data.reserve(people.size() * 8);
+    for (const Person& p : people) {
+        float startTime = 0.0f;
+        float inst[8] = { p.pos.x, p.pos.y, p.rowTarget.x, p.rowTarget.y,
+                          p.finalTarget.x, p.finalTarget.y, Theater::WALK_SPEED, startTime };
+        data.insert(data.end(), inst, inst + 8);
+    }
+    if (!crowdVAO) {
+        glGenVertexArrays(1, &crowdVAO);
+        glGenBuffers(1, &crowdVBO);
+        GLState::bindVertexArray(crowdVAO);
+        // shared unit quad
+        GLState::bindBuffer(GL_ARRAY_BUFFER, unitQuadVBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, unitQuadEBO);
+        // per-person path, advancing every second instance (body, head)
+        GLState::bindBuffer(GL_ARRAY_BUFFER, crowdVBO);
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+        glVertexAttribDivisor(2, 2);
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(4 * sizeof(float)));
+        glVertexAttribDivisor(3, 2);
+        GLState::bindVertexArray(0);
     }
+    GLState::bindBuffer(GL_ARRAY_BUFFER, crowdVBO);
+    glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_STATIC_DRAW);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    uploadedCrowd = theater->crowdVersion();
+}
 
-    if (allGone && filmTimer >= filmTime) {
-        people.clear();
-        for (auto& s : seats) s.state = 0;
-        simulationRunning = false;
+void drawCrowd() {
+    if (uploadedCrowd != theater->crowdVersion()) uploadCrowd();
+    crowdShader->use();
+    crowdShader->setFloat("uTime", theater->crowdTime());
+    crowdShader->setFloat("uExitTime", theater->exitTime());
+    GLState::bindVertexArray(crowdVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, (GLsizei)theater->people().size() * 2);
+}
+
+// Enter: the audience comes in; the overlay stays off until the session is over.
+// Network booking closes first, so every booking a client was told OK is in the
+// sync the audience is drawn from.
+void startSession() {
+    if (bookingServer) bookingServer->setOpen(false);
+    theater->startSimulation();
+    if (bookingServer && !theater->simulationRunning()) bookingServer->setOpen(true); // nobody booked
+    overlay = false;
+}
+
+// Per frame: bookings, hold expiry and the simulation advance by the wall time
+void updateTheater(double elapsed) {
+    bool wasRunning = theater->simulationRunning();
+    theater->update(elapsed);
+    if (wasRunning && !theater->simulationRunning()) {
         overlay = true;
-        // reset film color
-        filmColor = glm::vec4(0.05f, 0.05f, 0.2f, 1.0f);
+        if (bookingServer) bookingServer->setOpen(true);
     }
 }
 
 void renderScene() {
-    // background
-    drawQuad(0, 0, (float)SCR_W, (float)SCR_H, glm::vec4(0.02f, 0.02f, 0.05f, 1.0f));
+    updateStaticLayer();
+    drawList.begin();
+    // background and seats
+    drawList.custom(compositeStaticLayer);
     // screen (at top)
-    drawQuad(SCR_W * 0.25f, SCR_H - 160.0f, SCR_W * 0.5f, 100.0f, filmColor);
-    // seats
-    for (int i = 0; i < (int)seats.size(); ++i) {
-        Seat& s = seats[i];
-        glm::vec4 color = glm::vec4(0.2f, 0.4f, 0.9f, 1.0f); // free blue
-        if (s.state == 1) color = glm::vec4(0.9f, 0.9f, 0.2f, 1.0f); // reserved yellow
-        if (s.state == 2) color = glm::vec4(0.9f, 0.2f, 0.2f, 1.0f); // bought red
-        drawQuad(s.x, s.y, s.w, s.h, color);
-    }
+    Color film = theater->filmColor();
+    drawQuad(SCR_W * 0.25f, SCR_H - 160.0f, SCR_W * 0.5f, 100.0f, glm::vec4(film.r, film.g, film.b, film.a));
     // people (body + head)
-    for (auto& p : people) {
-        drawQuad(p.pos.x - 8.0f, p.pos.y - 12.0f, 16.0f, 24.0f, glm::vec4(0.2f, 0.8f, 0.2f, 1.0f));
-        drawQuad(p.pos.x - 6.0f, p.pos.y + 12.0f, 12.0f, 12.0f, glm::vec4(1.0f, 0.8f, 0.6f, 1.0f));
+    const std::vector<Person>& people = theater->people();
+    if (gpuCrowd && !people.empty()) {
+        drawList.custom(drawCrowd);
+    }
+    else {
+        float alpha = theater->renderAlpha();
+        for (auto& p : people) {
+            glm::vec2 pos(p.prevPos.x + (p.pos.x - p.prevPos.x) * alpha, p.prevPos.y + (p.pos.y - p.prevPos.y) * alpha);
+            drawQuad(pos.x - 8.0f, pos.y - 12.0f, 16.0f, 24.0f, glm::vec4(0.2f, 0.8f, 0.2f, 1.0f));
+            drawQuad(pos.x - 6.0f, pos.y + 12.0f, 12.0f, 12.0f, glm::vec4(1.0f, 0.8f, 0.6f, 1.0f));
+        }
+    }
+    // hovered seat, while seats can still be picked
+    if (!theater->simulationRunning()) {
+        int hovered = seatAtPos(cursorX, cursorY);
+        if (hovered >= 0) {
+            SeatRect s = theater->seats().rect(hovered);
+            drawQuad(s.x, s.y, s.w, s.h, glm::vec4(1.0f, 1.0f, 1.0f, 0.25f));
+        }
     }
     // overlay
     if (overlay) {
         drawQuad(0, 0, (float)SCR_W, (float)SCR_H, glm::vec4(0.0f, 0.0f, 0.0f, 0.5f));
     }
-    // student info
+    // student info, over everything but the cursor
     drawQuad(8, 8, 360, 60, glm::vec4(0.0f, 0.0f, 0.0f, 0.5f));
 
     // draw custom cursor - a simple film camera icon
-    double mx, my; glfwGetCursorPos(glfwGetCurrentContext(), &mx, &my);
-    int myg = screenToGLY(my);
-    float cx = (float)mx, cy = (float)myg;
+    float cx = (float)cursorX, cy = (float)screenToGLY(cursorY);
     // camera body
     drawQuad(cx - 12, cy - 8, 18, 12, glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
     // lens
@@ -330,10 +344,152 @@ void renderScene() {
     // reels
     drawQuad(cx - 18, cy + 2, 8, 8, glm::vec4(0.2f, 0.2f, 0.2f, 1.0f));
     drawQuad(cx - 6, cy + 6, 8, 8, glm::vec4(0.2f, 0.2f, 0.2f, 1.0f));
+
+    drawList.submit(*shader);
+}
+
+void initRenderer() {
+    glViewport(0, 0, SCR_W, SCR_H);
+    GLState::enableBlend(true); GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    shader = new Shader("shaders/quad.vert", "shaders/quad.frag");
+    seatShader = new Shader("shaders/seat.vert", "shaders/quad.frag");
+    blitShader = new Shader("shaders/blit.vert", "shaders/blit.frag");
+    crowdShader = new Shader("shaders/crowd.vert", "shaders/quad.frag");
+    crowdShader->use();
+    crowdShader->setFloat("uExitSpeed", Theater::EXIT_SPEED);
+    blitShader->use();
+    blitShader->setInt("uTex", 0);
+    glGenVertexArrays(1, &blitVAO);
+    initUnitQuad();
+    drawList.init();
+    staticList.init();
+
+    proj = glm::ortho(0.0f, (float)SCR_W, 0.0f, (float)SCR_H, -1.0f, 1.0f);
+    updateCamera();
+
+    theater.reset(new Theater(SCR_W, SCR_H, &venue));
+    theater->setAnalyticCrowd(gpuCrowd);
+    initSeatInstances();
+    staticLayer.create(SCR_W, SCR_H);
+}
+
+void destroyRenderer() {
+    drawList.destroy();
+    staticList.destroy();
+    staticLayer.destroy();
+    delete shader;
+    delete seatShader;
+    delete blitShader;
+    delete crowdShader;
+    if (crowdVAO) GLState::deleteVertexArray(crowdVAO);
+    if (crowdVBO) GLState::deleteBuffer(crowdVBO);
+    if (blitVAO) GLState::deleteVertexArray(blitVAO);
+    if (seatVAO) GLState::deleteVertexArray(seatVAO);
+    if (seatInstanceVBO) GLState::deleteBuffer(seatInstanceVBO);
+    if (cameraUBO) GLState::deleteBuffer(cameraUBO);
+    if (unitQuadVBO) GLState::deleteBuffer(unitQuadVBO);
+    if (unitQuadEBO) GLState::deleteBuffer(unitQuadEBO);
+    theater.reset();
+}
+
+struct HeadlessOptions {
+    const char* dumpDir = nullptr; // write frames as PPM here when set
+    int dumpEvery = 30;            // every n-th frame is dumped
+    int maxFrames = 20000;         // safety stop should the session never end
+    const char* walPath = nullptr; // --wal
+    const char* listenAddress = nullptr; // --listen
+};
+
+// Scripted session without a window: book seats, press Enter, play the film until
+// everybody has left, then print frame-time statistics. Time advances by a fixed
+// 1/75 s per frame and the crowd is seeded, so runs are comparable across machines.
+int runHeadless(const HeadlessOptions& opt) {
+    if (!Headless::createContext()) return -1;
+    initRenderer();
+    RenderTarget frameTarget;
+    if (!frameTarget.create(SCR_W, SCR_H)) { destroyRenderer(); Headless::destroyContext(); return -1; }
+    if ((opt.walPath && !theater->openLog(opt.walPath)) || (opt.listenAddress && !startBookingServer(opt.listenAddress))) {
+        destroyRenderer(); Headless::destroyContext(); return -1;
+    }
+    RenderTarget::setDefault(frameTarget.framebuffer());
+    theater->setSeed(75);
+
+    // box office: a few single reservations (as if clicked) and group purchases
+    for (int i = 0; i < theater->seats().size(); i += 5) theater->toggleSeat(i);
+    for (int n : { 4, 3, 2, 6, 1 }) theater->buyNSeats(n);
+
+    const float dt = 1.0f / 75.0f;
+    FrameStats stats;
+    GLState::resetCounters();
+    bool started = false;
+    int frame = 0;
+    for (; frame < opt.maxFrames; ++frame) {
+        if (frame == 30) { startSession(); started = true; } // Enter
+        if (started && !theater->simulationRunning()) break; // film is over and the hall is empty
+
+        auto start = std::chrono::steady_clock::now();
+        updateTheater(dt);
+        RenderTarget::bindDefault();
+        glClearColor(0.02f, 0.02f, 0.06f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        renderScene();
+        glFinish(); // count the GPU work too, there is no swap to wait on
+        stats.add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        if (opt.dumpDir && frame % opt.dumpEvery == 0) {
+            char path[512];
+            std::snprintf(path, sizeof(path), "%s/frame_%05d.ppm", opt.dumpDir, frame);
+            Headless::writeFrame(path, SCR_W, SCR_H);
+        }
+    }
+
+    std::cout << "headless " << SCR_W << "x" << SCR_H << ", " << theater->people().size() << " people at the end, "
+              << (started && !theater->simulationRunning() ? "session finished" : "frame limit reached") << "\n";
+    stats.report(std::cout);
+    const GLState::Counters& gl = GLState::counters();
+    std::cout << "GL binds issued " << gl.issued << ", skipped " << gl.skipped << "\n";
+    stopBookingServer();
+    if (theater->log().isOpen()) {
+        theater->closeLog();
+        const SeatLog& log = theater->log();
+        std::cout << "seat log: " << log.durableLsn() << " records, " << log.syncs() << " syncs, "
+                  << theater->checkpoints().written() << " snapshots, " << log.trims() << " trims\n";
+    }
+
+    RenderTarget::setDefault(0);
+    frameTarget.destroy();
+    destroyRenderer();
+    Headless::destroyContext();
+    return 0;
 }
 
-int main() {
+int main(int argc, char** argv) {
     std::srand((unsigned int)std::time(nullptr));
+
+    // movie [--venue FILE] [--wal FILE] [--listen PORT|SOCKET] [--vsync] | --headless [--size WxH] [--dump DIR] [--dump-every N] [--max-frames N]
+    //       --compile-venue TEXT BINARY
+    bool headless = false, vsync = false;
+    HeadlessOptions headlessOpt;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--headless") == 0) headless = true;
+        else if (std::strcmp(argv[i], "--vsync") == 0) vsync = true;
+        else if (std::strcmp(argv[i], "--venue") == 0 && hasValue) { if (!venue.open(argv[++i])) return -1; }
+        else if (std::strcmp(argv[i], "--wal") == 0 && hasValue) headlessOpt.walPath = argv[++i];
+        else if (std::strcmp(argv[i], "--listen") == 0 && hasValue) headlessOpt.listenAddress = argv[++i];
+        else if (std::strcmp(argv[i], "--compile-venue") == 0 && i + 2 < argc) {
+            bool ok = compileVenue(argv[i + 1], argv[i + 2]);
+            return ok ? 0 : -1;
+        }
+        else if (std::strcmp(argv[i], "--size") == 0 && hasValue) std::sscanf(argv[++i], "%dx%d", &SCR_W, &SCR_H);
+        else if (std::strcmp(argv[i], "--dump") == 0 && hasValue) headlessOpt.dumpDir = argv[++i];
+        else if (std::strcmp(argv[i], "--dump-every") == 0 && hasValue) headlessOpt.dumpEvery = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--max-frames") == 0 && hasValue) headlessOpt.maxFrames = std::atoi(argv[++i]);
+        else { std::cerr << "Unknown argument " << argv[i] << "\n"; return -1; }
+    }
+    if (headless) return runHeadless(headlessOpt);
+
     if (!glfwInit()) { std::cerr << "Failed to init GLFW\n"; return -1; }
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -352,38 +508,36 @@ int main() {
         std::cerr << "Failed to init GLAD\n"; return -1;
     }
 
-    glViewport(0, 0, SCR_W, SCR_H);
-    glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    shader = new Shader("shaders/quad.vert", "shaders/quad.frag");
-    initQuad();
-
-    proj = glm::ortho(0.0f, (float)SCR_W, 0.0f, (float)SCR_H, -1.0f, 1.0f);
-
-    setupSeats();
+    glfwSwapInterval(vsync ? 1 : 0);
 
-    // define entrance (top-left small margin)
-    entrancePos = glm::vec2(30.0f, SCR_H - 30.0f);
+    initRenderer();
+    if ((headlessOpt.walPath && !theater->openLog(headlessOpt.walPath))
+        || (headlessOpt.listenAddress && !startBookingServer(headlessOpt.listenAddress))) {
+        destroyRenderer(); glfwTerminate(); return -1;
+    }
 
     // hide system cursor
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
 
     bool keyWasPressed[10] = { false }; // index 0..9 corresponds to keys '0'..'9'
     bool enterWasPressed = false;
+    bool policyWasPressed = false;
 
-    auto lastTime = std::chrono::high_resolution_clock::now();
-    const double targetFrame = 1.0 / 75.0;
+    auto lastTime = std::chrono::steady_clock::now();
+    FramePacer pacer;
+    pacer.start(75.0, vsync);
 
     while (!glfwWindowShouldClose(window)) {
-        auto start = std::chrono::high_resolution_clock::now();
+        auto start = std::chrono::steady_clock::now();
         double elapsed = std::chrono::duration<double>(start - lastTime).count();
         lastTime = start;
 
         // input handling
         glfwPollEvents();
+        glfwGetCursorPos(window, &cursorX, &cursorY);
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) glfwSetWindowShouldClose(window, true);
 
-        if (!simulationRunning) {
+        if (!theater->simulationRunning()) {
             // handle number keys with edge-detection (press-once behavior)
             for (int k = GLFW_KEY_1; k <= GLFW_KEY_9; ++k) {
                 int state = glfwGetKey(window, k);
@@ -392,7 +546,7 @@ int main() {
                     // rising edge -> process once
                     keyWasPressed[idx] = true;
                     int n = idx; // number of seats requested
-                    if (n >= 1 && n <= 9) { buyNSeats(n);}
+                    if (n >= 1 && n <= 9) { theater->buyNSeats(n);}
                 }
                 else if (state == GLFW_RELEASE) {
                     // key released -> allow next press to trigger
@@ -400,12 +554,21 @@ int main() {
                 }
             }
 
+            // C: toggle where groups bought with 1-9 are placed
+            int policyState = glfwGetKey(window, GLFW_KEY_C);
+            if (policyState == GLFW_PRESS && !policyWasPressed) {
+                policyWasPressed = true;
+                theater->setSeatPolicy(theater->seatPolicy() == SeatPolicy::Center ? SeatPolicy::BackRightmost : SeatPolicy::Center);
+            }
+            else if (policyState == GLFW_RELEASE) {
+                policyWasPressed = false;
+            }
+
             // Enter: rising edge only
             int entState = glfwGetKey(window, GLFW_KEY_ENTER);
             if (entState == GLFW_PRESS && !enterWasPressed) {
                 enterWasPressed = true;
-                startSimulation();
-                overlay = false;
+                startSession();
             }
             else if (entState == GLFW_RELEASE) {
                 enterWasPressed = false;
@@ -416,14 +579,13 @@ int main() {
         static bool wasLeft = false;
         int state = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT);
         if (state == GLFW_PRESS && !wasLeft) {
-            double mx, my; glfwGetCursorPos(window, &mx, &my);
-            int idx = seatAtPos(mx, my);
-            if (idx >= 0 && !simulationRunning) { toggleSeat(idx); }
+            int idx = seatAtPos(cursorX, cursorY);
+            if (idx >= 0 && !theater->simulationRunning()) { theater->toggleSeat(idx); }
         }
         wasLeft = (state == GLFW_PRESS);
 
-        // update simulation
-        updateSimulation((float)elapsed);
+        // bookings, hold expiry and the simulation (in fixed ticks)
+        updateTheater(elapsed);
 
         // render
         glClearColor(0.02f, 0.02f, 0.06f, 1.0f);
@@ -431,19 +593,15 @@ int main() {
         renderScene();
 
         glfwSwapBuffers(window);
-
-        // simple frame limiter
-        auto end = std::chrono::high_resolution_clock::now();
-        double frameTime = std::chrono::duration<double>(end - start).count();
-        double sleepTime = targetFrame - frameTime;
-        if (sleepTime > 0) std::this_thread::sleep_for(std::chrono::duration<double>(sleepTime));
+        pacer.wait();
     }
 
-    delete shader;
-    if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
-    if (quadVBO) glDeleteBuffers(1, &quadVBO);
-    if (quadEBO) glDeleteBuffers(1, &quadEBO);
+    std::cout << "frames " << pacer.frames() << ", missed deadlines " << pacer.missedDeadlines()
+              << (pacer.vsync() ? " (vsync)" : " (75 fps)") << "\n";
 
+    stopBookingServer();
+    theater->closeLog();
+    destroyRenderer();
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
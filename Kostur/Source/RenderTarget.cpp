@@ -0,0 +1,42 @@
+#include "../Header/RenderTarget.h"
+#include "../Header/GLState.h"
+#include <glad/glad.h>
+#include <iostream>
+
+static unsigned int defaultFramebuffer = 0;
+
+bool RenderTarget::create(int width, int height) {
+    destroy();
+    w = width; h = height;
+    glGenTextures(1, &colorTex);
+    GLState::bindTexture(0, GL_TEXTURE_2D, colorTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &fbo);
+    GLState::bindFramebuffer(fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTex, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    bindDefault();
+    if (!complete) {
+        std::cerr << "Render target " << w << "x" << h << " is incomplete\n";
+        destroy();
+    }
+    return complete;
+}
+
+void RenderTarget::destroy() {
+    if (fbo) GLState::deleteFramebuffer(fbo);
+    if (colorTex) GLState::deleteTexture(colorTex);
+    fbo = colorTex = 0;
+    w = h = 0;
+}
+
+void RenderTarget::bind() const { GLState::bindFramebuffer(fbo); }
+
+void RenderTarget::bindDefault() { GLState::bindFramebuffer(defaultFramebuffer); }
+
+void RenderTarget::setDefault(unsigned int framebuffer) { defaultFramebuffer = framebuffer; }
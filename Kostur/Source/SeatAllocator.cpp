@@ -0,0 +1,133 @@
+#include "../Header/SeatAllocator.h"
+#include <algorithm>
+#include <cstdlib>
+
+void SeatAllocator::init(int r, int c) {
+    rows = r; cols = c;
+    colLeaves = 1; while (colLeaves < cols) colLeaves *= 2;
+    rowLeaves = 1; while (rowLeaves < rows) rowLeaves *= 2;
+    // padding leaves past the last column stay occupied, so runs never extend into them
+    runs.assign((size_t)rows * 2 * colLeaves, Run{ 0, 0, 0 });
+    rowBest.assign(2 * rowLeaves, 0);
+    for (int row = 0; row < rows; ++row) {
+        Run* t = rowTree(row);
+        for (int col = 0; col < cols; ++col) t[colLeaves + col] = Run{ 1, 1, 1 };
+        for (uint32_t len = 2, first = colLeaves / 2; first >= 1; len *= 2, first /= 2)
+            for (int node = first; node < 2 * (int)first; ++node) pull(t, node, len);
+        updateRow(row);
+    }
+}
+
+void SeatAllocator::pull(Run* t, int node, uint32_t len) {
+    const Run& a = t[2 * node];
+    const Run& b = t[2 * node + 1];
+    uint32_t half = len / 2;
+    t[node].prefix = a.prefix == half ? half + b.prefix : a.prefix;
+    t[node].suffix = b.suffix == half ? half + a.suffix : b.suffix;
+    t[node].best = std::max({ a.best, b.best, a.suffix + b.prefix });
+}
+
+void SeatAllocator::updateRow(int row) {
+    int node = rowLeaves + row;
+    rowBest[node] = rowTree(row)[1].best;
+    for (node /= 2; node >= 1; node /= 2)
+        rowBest[node] = std::max(rowBest[2 * node], rowBest[2 * node + 1]);
+}
+
+void SeatAllocator::setFree(int row, int col, bool free) {
+    Run* t = rowTree(row);
+    int node = colLeaves + col;
+    uint32_t v = free ? 1 : 0;
+    if (t[node].best == v) return;
+    t[node] = Run{ v, v, v };
+    for (uint32_t len = 2; (node /= 2) >= 1; len *= 2) pull(t, node, len);
+    updateRow(row);
+}
+
+// Highest row <= maxRow whose longest run is at least n
+int SeatAllocator::lastRowWithRun(int node, int lo, int hi, int maxRow, uint32_t n) const {
+    if (lo > maxRow || rowBest[node] < n) return -1;
+    if (lo == hi) return lo;
+    int mid = (lo + hi) / 2;
+    int r = lastRowWithRun(2 * node + 1, mid + 1, hi, maxRow, n);
+    return r >= 0 ? r : lastRowWithRun(2 * node, lo, mid, maxRow, n);
+}
+
+// Lowest row >= minRow whose longest run is at least n
+int SeatAllocator::firstRowWithRun(int node, int lo, int hi, int minRow, uint32_t n) const {
+    if (hi < minRow || lo >= rows || rowBest[node] < n) return -1;
+    if (lo == hi) return lo;
+    int mid = (lo + hi) / 2;
+    int r = firstRowWithRun(2 * node, lo, mid, minRow, n);
+    return r >= 0 ? r : firstRowWithRun(2 * node + 1, mid + 1, hi, minRow, n);
+}
+
+// Start of the right-most block of n free seats within columns [0, maxCol]. Nodes are
+// visited right to left; carry is the free run that starts just right of the current
+// node (inside the range), so blocks crossing node borders are found too.
+int SeatAllocator::lastBlock(const Run* t, int node, int lo, int hi, int maxCol, uint32_t n, uint32_t& carry) const {
+    if (lo > maxCol) return -1;
+    if (hi <= maxCol) {
+        const Run& x = t[node];
+        uint32_t len = hi - lo + 1;
+        if (x.suffix + carry >= n) return hi + (int)carry - (int)n + 1;
+        if (x.best < n) {
+            carry = x.prefix == len ? len + carry : x.prefix;
+            return -1;
+        }
+    }
+    int mid = (lo + hi) / 2;
+    int r = lastBlock(t, 2 * node + 1, mid + 1, hi, maxCol, n, carry);
+    return r >= 0 ? r : lastBlock(t, 2 * node, lo, mid, maxCol, n, carry);
+}
+
+// Start of the left-most block of n free seats within columns [minCol, cols); mirror of lastBlock()
+int SeatAllocator::firstBlock(const Run* t, int node, int lo, int hi, int minCol, uint32_t n, uint32_t& carry) const {
+    if (hi < minCol) return -1;
+    if (lo >= minCol) {
+        const Run& x = t[node];
+        uint32_t len = hi - lo + 1;
+        if (carry + x.prefix >= n) return lo - (int)carry;
+        if (x.best < n) {
+            carry = x.suffix == len ? carry + len : x.suffix;
+            return -1;
+        }
+    }
+    int mid = (lo + hi) / 2;
+    int r = firstBlock(t, 2 * node, lo, mid, minCol, n, carry);
+    return r >= 0 ? r : firstBlock(t, 2 * node + 1, mid + 1, hi, minCol, n, carry);
+}
+
+// Block whose start is nearest to the centered position: the best candidate left of
+// (or at) the center and the best one right of it, whichever is closer
+int SeatAllocator::closestBlock(int row, int n) const {
+    const Run* t = rowTree(row);
+    int ideal = (cols - n) / 2;
+    uint32_t carry = 0;
+    int left = lastBlock(t, 1, 0, colLeaves - 1, ideal + n - 1, n, carry);
+    carry = 0;
+    int right = firstBlock(t, 1, 0, colLeaves - 1, ideal, n, carry);
+    if (left < 0) return right;
+    if (right < 0) return left;
+    return ideal - left <= right - ideal ? left : right;
+}
+
+bool SeatAllocator::find(int n, SeatPolicy policy, int& row, int& col) const {
+    if (n <= 0 || n > cols || rows == 0 || rowBest[1] < (uint32_t)n) return false;
+
+    if (policy == SeatPolicy::BackRightmost) {
+        row = lastRowWithRun(1, 0, rowLeaves - 1, rows - 1, n);
+        uint32_t carry = 0;
+        col = lastBlock(rowTree(row), 1, 0, colLeaves - 1, cols - 1, n, carry);
+        return true;
+    }
+
+    // nearest rows on either side of the middle; distances are doubled to stay integral
+    int below = lastRowWithRun(1, 0, rowLeaves - 1, (rows - 1) / 2, n);
+    int above = firstRowWithRun(1, 0, rowLeaves - 1, rows / 2, n);
+    if (below < 0) row = above;
+    else if (above < 0) row = below;
+    else row = std::abs(2 * above - (rows - 1)) <= std::abs(2 * below - (rows - 1)) ? above : below;
+    col = closestBlock(row, n);
+    return true;
+}
@@ -0,0 +1,213 @@
+#include "../Header/SeatLog.h"
+#include "../Header/FileIO.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const uint32_t BATCH_MAGIC = 0x4C415753; // "SWAL"
+    const auto GROUP_WINDOW = std::chrono::milliseconds(5);
+    const int WRITE_ATTEMPTS = 3;
+
+    // batch on disk: header, count records, crc32 of header + records
+    struct BatchHeader {
+        uint32_t magic;
+        uint32_t count;
+        uint64_t firstLsn;
+    };
+}
+
+bool SeatLog::replay(const char* path, uint64_t skipLsn,
+                     const std::function<void(const SeatLogRecord&)>& apply, uint64_t& lastLsn) {
+    lastLsn = skipLsn;
+    std::vector<uint8_t> data;
+    if (!FileIO::readAll(path, data)) return true; // no log yet
+
+    size_t pos = 0;
+    while (pos + sizeof(BatchHeader) <= data.size()) {
+        BatchHeader h;
+        std::memcpy(&h, &data[pos], sizeof(h));
+        size_t body = (size_t)h.count * sizeof(SeatLogRecord);
+        size_t end = pos + sizeof(h) + body + sizeof(uint32_t);
+        if (h.magic != BATCH_MAGIC || end > data.size()) break;
+        uint32_t stored;
+        std::memcpy(&stored, &data[end - sizeof(uint32_t)], sizeof(stored));
+        if (FileIO::crc32(&data[pos], sizeof(h) + body) != stored) break;
+
+        const uint8_t* recs = &data[pos + sizeof(h)];
+        for (uint32_t i = 0; i < h.count; ++i) {
+            uint64_t lsn = h.firstLsn + i;
+            if (lsn <= skipLsn) continue; // already in the snapshot
+            SeatLogRecord r;
+            std::memcpy(&r, recs + i * sizeof(SeatLogRecord), sizeof(r));
+            apply(r);
+            lastLsn = lsn;
+        }
+        pos = end;
+    }
+    if (pos < data.size()) {
+        std::cerr << path << ": dropping " << data.size() - pos << " bytes of an incomplete batch\n";
+        if (!FileIO::truncate(path, pos)) { std::cerr << "Cannot truncate " << path << "\n"; return false; }
+    }
+    return true;
+}
+
+bool SeatLog::open(const char* path, uint64_t lastLsn) {
+    close();
+    fd = FileIO::openAppend(path);
+    if (fd < 0) { std::cerr << "Cannot open log " << path << "\n"; return false; }
+    int64_t size = FileIO::fileSize(fd);
+    if (size < 0) { std::cerr << "Cannot open log " << path << "\n"; FileIO::close(fd); fd = -1; return false; }
+    fileEnd = (uint64_t)size;
+    this->path = path;
+    nextLsn = lastLsn + 1;
+    queuedFirstLsn = nextLsn;
+    durable = lastLsn;
+    broken = false;
+    trimLsn = 0;
+    stopping = false;
+    written.clear();
+    if (fileEnd) written.push_back({ lastLsn, 0 }); // whatever is there now ends at lastLsn
+    writer = std::thread(&SeatLog::writerLoop, this);
+    return true;
+}
+
+void SeatLog::close() {
+    if (!writer.joinable()) return; // the writer may have lost fd already
+    {
+        std::lock_guard<std::mutex> g(lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    if (fd >= 0) FileIO::close(fd);
+    fd = -1;
+}
+
+void SeatLog::append(const SeatLogRecord& r) {
+    if (fd < 0 || broken.load(std::memory_order_relaxed)) return;
+    bool first;
+    {
+        std::lock_guard<std::mutex> g(lock);
+        first = queued.empty();
+        if (first) queuedFirstLsn = nextLsn;
+        queued.push_back(r);
+        ++nextLsn;
+    }
+    if (first) wake.notify_one();
+}
+
+void SeatLog::logState(int seat, uint8_t state) { append({ (uint32_t)seat, SeatLogRecord::SET, state, 0 }); }
+
+void SeatLog::logReset() { append({ 0, SeatLogRecord::RESET, 0, 0 }); }
+
+void SeatLog::trim(uint64_t lsn) {
+    {
+        std::lock_guard<std::mutex> g(lock);
+        if (lsn <= trimLsn) return;
+        trimLsn = lsn;
+    }
+    wake.notify_one();
+}
+
+// Drops the batches that end at or before upTo: the tail is copied into a new file
+// which then replaces the log. Runs on the writer thread, so no append can interleave.
+void SeatLog::cutBefore(uint64_t upTo) {
+    size_t keep = 0;
+    while (keep < written.size() && written[keep].lastLsn <= upTo) ++keep;
+    uint64_t from = keep < written.size() ? written[keep].offset : fileEnd;
+    if (from == 0) return;
+
+    // the tail a chunk at a time, so a trim costs no more memory than a big log's
+    std::string tmp = path + ".tmp";
+    int in = FileIO::openRead(path.c_str());
+    int out = in >= 0 ? FileIO::openWrite(tmp.c_str()) : -1;
+    bool ok = out >= 0;
+    uint8_t chunk[1 << 16];
+    for (uint64_t pos = from; ok && pos < fileEnd; ) {
+        size_t n = (size_t)std::min<uint64_t>(sizeof(chunk), fileEnd - pos);
+        ok = FileIO::readAt(in, pos, chunk, n) && FileIO::writeAll(out, chunk, n);
+        pos += n;
+    }
+    ok = ok && FileIO::syncData(out);
+    if (in >= 0) FileIO::close(in);
+    if (out >= 0) FileIO::close(out);
+    if (!ok) { std::cerr << "Cannot write " << tmp << "\n"; FileIO::remove(tmp.c_str()); return; }
+
+    FileIO::close(fd);
+    if (!FileIO::replace(tmp.c_str(), path.c_str())) FileIO::remove(tmp.c_str()); // gone if only the directory sync failed
+    fd = FileIO::openAppend(path.c_str());
+    if (fd < 0) { stopLogging("Cannot reopen log " + path); return; }
+    // the size tells which file we got: writeBatch cuts back to fileEnd, it must be right
+    int64_t size = FileIO::fileSize(fd);
+    if (size == (int64_t)fileEnd) { std::cerr << "Cannot replace " << path << ", keeping it uncut\n"; return; }
+    if (size != (int64_t)(fileEnd - from)) {
+        FileIO::close(fd);
+        fd = -1;
+        stopLogging("Cannot tell whether " + path + " was cut");
+        return;
+    }
+    written.erase(written.begin(), written.begin() + keep);
+    for (WrittenBatch& b : written) b.offset -= from;
+    fileEnd -= from;
+    trimCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Nothing more reaches the disk: append() refuses records from now on
+void SeatLog::stopLogging(const std::string& why) {
+    broken.store(true, std::memory_order_release);
+    std::cerr << why << ", bookings after LSN " << durable.load() << " are not durable; logging stopped\n";
+}
+
+// Appends one batch and syncs it. A failed attempt is cut off again (the file ends
+// at fileEnd before every attempt), so a torn batch never sits in front of later ones.
+bool SeatLog::writeBatch(const std::vector<uint8_t>& buffer) {
+    for (int attempt = 0; attempt < WRITE_ATTEMPTS; ++attempt) {
+        if (FileIO::writeAll(fd, buffer.data(), buffer.size()) && FileIO::syncData(fd)) return true;
+        if (!FileIO::truncate(fd, fileEnd)) break;
+    }
+    return false;
+}
+
+void SeatLog::writerLoop() {
+    std::vector<SeatLogRecord> batch;
+    std::vector<uint8_t> buffer;
+    uint64_t trimmed = 0;
+    for (;;) {
+        uint64_t firstLsn, trimTo;
+        {
+            std::unique_lock<std::mutex> g(lock);
+            wake.wait(g, [&] { return stopping || !queued.empty() || trimLsn > trimmed; });
+            if (queued.empty() && stopping) return;
+            // let more records join this batch, unless we are shutting down
+            if (!queued.empty() && !stopping) wake.wait_for(g, GROUP_WINDOW, [&] { return stopping; });
+            batch.swap(queued);
+            firstLsn = queuedFirstLsn;
+            trimTo = trimLsn;
+        }
+
+        if (trimTo > trimmed) {
+            cutBefore(trimTo);
+            trimmed = trimTo;
+        }
+        if (batch.empty() || fd < 0 || broken.load(std::memory_order_relaxed)) { batch.clear(); continue; }
+
+        BatchHeader h = { BATCH_MAGIC, (uint32_t)batch.size(), firstLsn };
+        buffer.resize(sizeof(h) + batch.size() * sizeof(SeatLogRecord) + sizeof(uint32_t));
+        std::memcpy(buffer.data(), &h, sizeof(h));
+        std::memcpy(buffer.data() + sizeof(h), batch.data(), batch.size() * sizeof(SeatLogRecord));
+        uint32_t crc = FileIO::crc32(buffer.data(), buffer.size() - sizeof(uint32_t));
+        std::memcpy(buffer.data() + buffer.size() - sizeof(uint32_t), &crc, sizeof(crc));
+
+        if (!writeBatch(buffer)) stopLogging("Seat log write failed");
+        else {
+            uint64_t last = firstLsn + batch.size() - 1;
+            written.push_back({ last, fileEnd });
+            fileEnd += buffer.size();
+            durable.store(last, std::memory_order_release);
+            syncCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        batch.clear();
+    }
+}
@@ -0,0 +1,45 @@
+#include "../Header/SeatMap.h"
+#include <algorithm>
+
+void SeatMap::resize(int rows, int cols) {
+    nRows = rows; nCols = cols;
+    size_t n = (size_t)rows * cols;
+    states.assign(n, 0);
+    owned.assign(4 * n, 0.0f);
+    xs = owned.data(); ys = xs + n;
+    ws = ys + n; hs = ws + n;
+    setTransform(1.0f, 0.0f, 0.0f);
+}
+
+void SeatMap::resizeGrid(int rows, int cols, const SeatRect& area, float* pitchX, float* pitchY) {
+    resize(rows, cols);
+    float seatW = (area.w / (float)cols) * 0.75f;
+    float seatH = (area.h / (float)rows) * 0.5f;
+    float spacingX = (area.w - seatW * cols) / std::max(1, cols - 1);
+    float spacingY = (area.h - seatH * rows) / std::max(1, rows - 1);
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+            setRect(index(r, c), { area.x + c * (seatW + spacingX), area.y + r * (seatH + spacingY), seatW, seatH });
+    if (pitchX) *pitchX = seatW + spacingX;
+    if (pitchY) *pitchY = seatH + spacingY;
+}
+
+void SeatMap::attach(int rows, int cols, const float* x, const float* y, const float* w, const float* h,
+                     const uint8_t* initialStates) {
+    nRows = rows; nCols = cols;
+    states.assign(initialStates, initialStates + (size_t)rows * cols);
+    owned.clear();
+    xs = x; ys = y;
+    ws = w; hs = h;
+    setTransform(1.0f, 0.0f, 0.0f);
+}
+
+void SeatMap::setTransform(float s, float offsetX, float offsetY) {
+    scale = s; offX = offsetX; offY = offsetY;
+}
+
+void SeatMap::setRect(int i, const SeatRect& r) {
+    size_t n = states.size();
+    owned[i] = r.x; owned[n + i] = r.y;
+    owned[2 * n + i] = r.w; owned[3 * n + i] = r.h;
+}
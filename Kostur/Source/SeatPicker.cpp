@@ -0,0 +1,78 @@
+#include "../Header/SeatPicker.h"
+#include <algorithm>
+#include <cmath>
+
+static bool inside(const SeatRect& r, float x, float y) {
+    return x >= r.x && x <= r.x + r.w && y >= r.y && y <= r.y + r.h;
+}
+
+GridPicker::GridPicker(const SeatMap& s, float ox, float oy, float px, float py)
+    : seats(s), originX(ox), originY(oy), pitchX(px), pitchY(py) {}
+
+int GridPicker::pick(float x, float y) const {
+    int c = (int)std::floor((x - originX) / pitchX);
+    int r = (int)std::floor((y - originY) / pitchY);
+    if (c < 0 || r < 0 || c >= seats.cols() || r >= seats.rows()) return -1;
+    int idx = seats.index(r, c);
+    return inside(seats.rect(idx), x, y) ? idx : -1; // the spacing between seats is no hit
+}
+
+BinPicker::BinPicker(const SeatMap& s) : seats(s) {
+    float sumW = 0, sumH = 0;
+    int n = 0;
+    for (int i = 0; i < seats.size(); ++i) {
+        if (seats.state(i) == 3) continue; // empty slot
+        SeatRect r = seats.rect(i);
+        if (n == 0) { minX = r.x; minY = r.y; maxX = r.x + r.w; maxY = r.y + r.h; }
+        minX = std::min(minX, r.x); minY = std::min(minY, r.y);
+        maxX = std::max(maxX, r.x + r.w); maxY = std::max(maxY, r.y + r.h);
+        sumW += r.w; sumH += r.h;
+        ++n;
+    }
+    if (n == 0) return;
+
+    // bins about twice the average seat keep every bin down to a handful of seats
+    binW = std::max(2.0f * sumW / n, 1e-3f);
+    binH = std::max(2.0f * sumH / n, 1e-3f);
+    binsX = std::max(1, (int)std::ceil((maxX - minX) / binW));
+    binsY = std::max(1, (int)std::ceil((maxY - minY) / binH));
+
+    // counting sort: a seat goes into every bin its rect touches
+    auto binRange = [&](const SeatRect& r, int& x0, int& y0, int& x1, int& y1) {
+        x0 = std::min(binsX - 1, (int)((r.x - minX) / binW));
+        y0 = std::min(binsY - 1, (int)((r.y - minY) / binH));
+        x1 = std::min(binsX - 1, (int)((r.x + r.w - minX) / binW));
+        y1 = std::min(binsY - 1, (int)((r.y + r.h - minY) / binH));
+    };
+    binStart.assign((size_t)binsX * binsY + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<int> fill;
+        if (pass == 1) {
+            for (size_t b = 1; b < binStart.size(); ++b) binStart[b] += binStart[b - 1];
+            binSeats.resize(binStart.back());
+            fill.assign(binStart.begin(), binStart.end() - 1);
+        }
+        for (int i = 0; i < seats.size(); ++i) {
+            if (seats.state(i) == 3) continue;
+            int x0, y0, x1, y1;
+            binRange(seats.rect(i), x0, y0, x1, y1);
+            for (int by = y0; by <= y1; ++by)
+                for (int bx = x0; bx <= x1; ++bx) {
+                    int b = by * binsX + bx;
+                    if (pass == 0) ++binStart[b + 1];
+                    else binSeats[fill[b]++] = i;
+                }
+        }
+    }
+}
+
+int BinPicker::pick(float x, float y) const {
+    if (binSeats.empty() || x < minX || y < minY || x > maxX || y > maxY) return -1;
+    int bx = std::min(binsX - 1, (int)((x - minX) / binW));
+    int by = std::min(binsY - 1, (int)((y - minY) / binH));
+    int b = by * binsX + bx;
+    // seats are listed in index order, so overlaps resolve like the old linear scan
+    for (int k = binStart[b]; k < binStart[b + 1]; ++k)
+        if (inside(seats.rect(binSeats[k]), x, y)) return binSeats[k];
+    return -1;
+}
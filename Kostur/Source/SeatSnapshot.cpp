@@ -0,0 +1,145 @@
+#include "../Header/SeatSnapshot.h"
+#include "../Header/FileIO.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+static_assert(sizeof(SnapshotHeader) == 64, "snapshot header layout");
+
+namespace {
+    uint64_t alignUp(uint64_t v) { return (v + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN; }
+
+    uint32_t headerCrc(SnapshotHeader h) {
+        h.headerCrc = 0;
+        return FileIO::crc32(&h, sizeof(h));
+    }
+
+    // page-aligned buffer, so the same bytes could go through O_DIRECT unchanged
+    struct AlignedBuffer {
+        uint8_t* data = nullptr;
+        explicit AlignedBuffer(size_t size) {
+#ifdef _WIN32
+            data = (uint8_t*)_aligned_malloc(size, SNAPSHOT_ALIGN);
+#else
+            void* p = nullptr;
+            if (posix_memalign(&p, SNAPSHOT_ALIGN, size) == 0) data = (uint8_t*)p;
+#endif
+            if (data) std::memset(data, 0, size);
+        }
+        ~AlignedBuffer() {
+#ifdef _WIN32
+            _aligned_free(data);
+#else
+            std::free(data);
+#endif
+        }
+    };
+}
+
+bool writeSnapshot(const char* path, const uint8_t* states, uint32_t rows, uint32_t cols, uint64_t lsn) {
+    SnapshotHeader h = {};
+    std::memcpy(h.magic, "SEAT", 4);
+    h.version = SNAPSHOT_VERSION;
+    h.rows = rows; h.cols = cols;
+    h.rowBytes = (cols + 3) / 4;
+    h.lsn = lsn;
+    h.dataOffset = SNAPSHOT_ALIGN;
+    h.dataSize = (uint64_t)rows * h.rowBytes;
+
+    size_t fileSize = (size_t)(SNAPSHOT_ALIGN + alignUp(h.dataSize));
+    AlignedBuffer buffer(fileSize);
+    if (!buffer.data) { std::cerr << "Out of memory for snapshot\n"; return false; }
+    uint8_t* packed = buffer.data + h.dataOffset;
+    for (uint32_t r = 0; r < rows; ++r) {
+        const uint8_t* src = states + (size_t)r * cols;
+        uint8_t* dst = packed + (size_t)r * h.rowBytes;
+        for (uint32_t c = 0; c < cols; ++c) dst[c >> 2] |= (uint8_t)((src[c] & 3) << ((c & 3) * 2));
+    }
+    h.dataCrc = FileIO::crc32(packed, (size_t)h.dataSize);
+    h.headerCrc = headerCrc(h);
+    std::memcpy(buffer.data, &h, sizeof(h));
+
+    std::string tmp = std::string(path) + ".tmp";
+    int fd = FileIO::openWrite(tmp.c_str());
+    if (fd < 0) { std::cerr << "Cannot create " << tmp << "\n"; return false; }
+    bool ok = FileIO::writeAll(fd, buffer.data, fileSize) && FileIO::syncData(fd);
+    FileIO::close(fd);
+    if (!ok || !FileIO::replace(tmp.c_str(), path)) { std::cerr << "Cannot write snapshot " << path << "\n"; return false; }
+    return true;
+}
+
+bool loadSnapshot(const char* path, SeatSnapshot& out) {
+    std::vector<uint8_t> file;
+    if (!FileIO::readAll(path, file)) return false;
+    if (file.size() < sizeof(SnapshotHeader)) { std::cerr << path << " is too small for a snapshot\n"; return false; }
+    SnapshotHeader h;
+    std::memcpy(&h, file.data(), sizeof(h));
+    bool valid = std::memcmp(h.magic, "SEAT", 4) == 0 && h.version == SNAPSHOT_VERSION
+        && h.headerCrc == headerCrc(h)
+        && h.rowBytes == (h.cols + 3) / 4 && h.dataSize == (uint64_t)h.rows * h.rowBytes
+        && h.dataOffset + h.dataSize <= file.size();
+    if (!valid) { std::cerr << path << " is not a version " << SNAPSHOT_VERSION << " seat snapshot\n"; return false; }
+    const uint8_t* packed = file.data() + h.dataOffset;
+    if (FileIO::crc32(packed, (size_t)h.dataSize) != h.dataCrc) { std::cerr << path << ": checksum mismatch\n"; return false; }
+
+    out.rows = h.rows; out.cols = h.cols;
+    out.lsn = h.lsn;
+    out.states.resize((size_t)h.rows * h.cols);
+    for (uint32_t r = 0; r < h.rows; ++r) {
+        const uint8_t* src = packed + (size_t)r * h.rowBytes;
+        uint8_t* dst = out.states.data() + (size_t)r * h.cols;
+        for (uint32_t c = 0; c < h.cols; ++c) dst[c] = (src[c >> 2] >> ((c & 3) * 2)) & 3;
+    }
+    return true;
+}
+
+void Checkpointer::start(const char* path) {
+    stop();
+    this->path = path;
+    stopping = false;
+    worker = std::thread(&Checkpointer::run, this);
+}
+
+void Checkpointer::stop() {
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> g(lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+bool Checkpointer::request(const uint8_t* states, uint32_t rows, uint32_t cols, uint64_t lsn) {
+    if (!running() || pending.load(std::memory_order_acquire)) return false;
+    {
+        std::lock_guard<std::mutex> g(lock);
+        staged.assign(states, states + (size_t)rows * cols);
+        stagedRows = rows; stagedCols = cols;
+        stagedLsn = lsn;
+        pending.store(true, std::memory_order_release);
+    }
+    wake.notify_one();
+    return true;
+}
+
+void Checkpointer::run() {
+    std::unique_lock<std::mutex> g(lock);
+    for (;;) {
+        wake.wait(g, [&] { return stopping || pending.load(std::memory_order_acquire); });
+        if (!pending.load(std::memory_order_acquire)) return; // stopping with nothing left to write
+        // staged is not touched by request() while pending is set
+        g.unlock();
+        bool ok = writeSnapshot(path.c_str(), staged.data(), stagedRows, stagedCols, stagedLsn);
+        if (ok) {
+            completed.store(stagedLsn, std::memory_order_release);
+            writtenCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        g.lock();
+        pending.store(false, std::memory_order_release);
+    }
+}
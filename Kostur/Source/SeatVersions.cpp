@@ -0,0 +1,141 @@
+#include "../Header/SeatVersions.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <thread>
+
+namespace {
+    const size_t CHUNK_TARGET = 256; // bytes per chunk, in whole rows
+    const int READ_PASSES = 8;       // over all slots before read() gives up
+}
+
+SeatView::SeatView(SeatView&& other) noexcept : ver(other.ver), slot(other.slot) {
+    other.slot = nullptr;
+}
+
+SeatView::~SeatView() {
+    if (!slot) return;
+    slot->pinned.store(0, std::memory_order_release);
+    slot->taken.store(false, std::memory_order_release);
+}
+
+SeatVersions::~SeatVersions() {
+    for (const Retired& r : retired) release(r.version);
+    if (Version* v = current.load()) release(v);
+    for (size_t i = 0; i < work.size(); ++i)
+        if (owned[i]) std::free(work[i]); // copies nobody has seen yet
+}
+
+SeatVersions::Chunk* SeatVersions::newChunk() {
+    size_t bytes = chunkBytes();
+    void* block = std::malloc(sizeof(Chunk) + bytes);
+    if (!block) throw std::bad_alloc();
+    Chunk* c = static_cast<Chunk*>(block);
+    c->refs = 0;
+    c->states = static_cast<uint8_t*>(block) + sizeof(Chunk);
+    return c;
+}
+
+void SeatVersions::init(int rows, int cols, const uint8_t* states) {
+    nRows = rows; nCols = cols;
+    rowsPerChunk = std::max(1, std::min(rows, (int)(CHUNK_TARGET / std::max(1, cols))));
+    int count = (nRows + rowsPerChunk - 1) / rowsPerChunk;
+    work.resize(count);
+    owned.assign(count, 1);
+    for (int i = 0; i < count; ++i) {
+        work[i] = newChunk();
+        std::memset(work[i]->states, 0, chunkBytes()); // the last chunk may have rows past the end
+        int firstRow = i * rowsPerChunk;
+        int n = std::min(rowsPerChunk, nRows - firstRow);
+        if (states) std::memcpy(work[i]->states, states + (size_t)firstRow * nCols, (size_t)n * nCols);
+    }
+    changed = true;
+    publish();
+}
+
+void SeatVersions::set(int seat, uint8_t state) {
+    int chunkSeats = rowsPerChunk * nCols;
+    int i = seat / chunkSeats;
+    if (work[i]->states[seat % chunkSeats] == state) return;
+    if (!owned[i]) {
+        // first change since the last publish: readers may hold this chunk, write a copy
+        Chunk* copy = newChunk();
+        std::memcpy(copy->states, work[i]->states, chunkBytes());
+        work[i] = copy;
+        owned[i] = 1;
+        ++copies;
+    }
+    work[i]->states[seat % chunkSeats] = state;
+    changed = true;
+}
+
+uint64_t SeatVersions::publish() {
+    if (!changed) return number;
+    if (retired.size() >= MAX_RETIRED) reclaim();
+    if (retired.size() >= MAX_RETIRED) {
+        // the changes stay in the next version, which goes out once the reader lets go
+        if (!held) std::cerr << "seat versions: a reader holds " << retired.size() << " old versions, publishing paused\n";
+        held = true;
+        return number;
+    }
+    held = false;
+    void* block = std::malloc(sizeof(Version) + work.size() * sizeof(Chunk*));
+    if (!block) throw std::bad_alloc();
+    Version* v = static_cast<Version*>(block);
+    v->number = ++number;
+    v->rows = nRows; v->cols = nCols;
+    v->rowsPerChunk = rowsPerChunk;
+    v->chunkSeats = rowsPerChunk * nCols;
+    v->chunks = reinterpret_cast<Chunk**>(static_cast<char*>(block) + sizeof(Version));
+    for (size_t i = 0; i < work.size(); ++i) {
+        v->chunks[i] = work[i];
+        ++work[i]->refs;
+    }
+    std::fill(owned.begin(), owned.end(), 0);
+    changed = false;
+
+    // readers that pin the epoch after the bump are sure to load v
+    Version* old = current.exchange(v);
+    if (old) retired.push_back({ old, epoch.fetch_add(1) });
+    reclaim();
+    return number;
+}
+
+void SeatVersions::release(Version* v) {
+    int count = (v->rows + v->rowsPerChunk - 1) / v->rowsPerChunk;
+    for (int i = 0; i < count; ++i)
+        if (--v->chunks[i]->refs == 0) std::free(v->chunks[i]);
+    std::free(v);
+}
+
+// Frees the versions replaced before the oldest epoch any reader is pinned at
+void SeatVersions::reclaim() {
+    uint64_t oldest = UINT64_MAX;
+    for (const SeatView::Slot& s : slots) {
+        uint64_t pinned = s.pinned.load();
+        if (pinned) oldest = std::min(oldest, pinned);
+    }
+    size_t kept = 0;
+    for (const Retired& r : retired) {
+        if (r.epoch < oldest) release(r.version);
+        else retired[kept++] = r;
+    }
+    retired.resize(kept);
+}
+
+SeatView SeatVersions::read() const {
+    int i = (int)(std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS);
+    for (int tried = 0; tried < READ_PASSES * MAX_READERS; i = (i + 1) % MAX_READERS) {
+        SeatView::Slot& s = slots[i];
+        bool expected = false;
+        if (!s.taken.load(std::memory_order_relaxed) && s.taken.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            s.pinned.store(epoch.load());
+            return SeatView(current.load(), &s);
+        }
+        if (++tried % MAX_READERS == 0) std::this_thread::yield(); // every slot in use
+    }
+    return SeatView(nullptr, nullptr);
+}
@@ -0,0 +1,353 @@
+#include "../Header/Theater.h"
+#include "../Header/Venue.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+    const int ROWS = 6;
+    const int COLS = 9; // 6x9 = 54 seats, in specification minimal is 50 seats (default hall without a venue)
+    const float MARGIN_X = 120.0f;
+    const float MARGIN_Y = 140.0f;
+    const double HOLD_TICK = 0.1; // timer wheel resolution, seconds
+    const uint64_t CHECKPOINT_EVERY = 256; // log records between snapshots
+    const float MAX_FRAME_DT = 0.25f; // longer hitches are dropped instead of replayed
+    const float FILM_COLOR_EVERY = 20.0f / 75.0f; // seconds; every 20 frames of the original 75 Hz loop
+
+    float distance(Point a, Point b) { return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y)); }
+
+    // Walks p toward target; true (and p snapped onto it) once within 2 units
+    bool stepTowards(Point& p, Point target, float speed, float dt) {
+        float dist = distance(p, target);
+        if (dist < 2.0f) { p = target; return true; }
+        float step = speed * dt / dist;
+        p.x += (target.x - p.x) * step;
+        p.y += (target.y - p.y) * step;
+        return false;
+    }
+}
+
+Theater::Theater(int width, int height, const VenueFile* venue) : w(width), h(height) {
+    if (venue && venue->isOpen()) setupVenueSeats(*venue);
+    else setupGridSeats(ROWS, COLS);
+    setupBookings();
+}
+
+Theater::Theater(int width, int height, int rows, int cols) : w(width), h(height) {
+    setupGridSeats(rows, cols);
+    setupBookings();
+}
+
+// Allocator, engine and versions start from the states of the layout
+void Theater::setupBookings() {
+    freeSeats.init(seatMap.rows(), seatMap.cols());
+    holdGen.assign(seatMap.size(), 0);
+    isDirty.assign(seatMap.size(), 0);
+    const uint8_t* state = seatMap.stateData();
+    for (int i = 0; i < seatMap.size(); ++i)
+        if (state[i] != 0) freeSeats.setFree(seatMap.row(i), seatMap.col(i), false);
+    engine.reset(new BookingEngine(seatMap.rows(), seatMap.cols(), state));
+    versions.init(seatMap.rows(), seatMap.cols(), state);
+}
+
+Theater::~Theater() {
+    closeLog();
+}
+
+void Theater::setupGridSeats(int rows, int cols) {
+    float pitchX, pitchY;
+    seatMap.resizeGrid(rows, cols, { MARGIN_X, MARGIN_Y, w - 2 * MARGIN_X, h - 2 * MARGIN_Y }, &pitchX, &pitchY);
+    // entrance (top-left small margin)
+    entrancePos = { 30.0f, h - 30.0f };
+    picker.reset(new GridPicker(seatMap, MARGIN_X, MARGIN_Y, pitchX, pitchY));
+}
+
+// Seats from the mapped venue file, scaled to fit the area the default grid uses
+void Theater::setupVenueSeats(const VenueFile& venue) {
+    const VenueHeader& vh = venue.header();
+    seatMap.attach((int)vh.rows, (int)vh.cols, venue.xs(), venue.ys(), venue.ws(), venue.hs(), venue.slotStates());
+    float areaW = w - 2 * MARGIN_X;
+    float areaH = h - 2 * MARGIN_Y;
+    float scale = std::min(areaW / vh.width, areaH / vh.height);
+    float offX = MARGIN_X + (areaW - vh.width * scale) * 0.5f;
+    float offY = MARGIN_Y + (areaH - vh.height * scale) * 0.5f;
+    seatMap.setTransform(scale, offX, offY);
+
+    aisleRects.clear();
+    const float* a = venue.aisles();
+    for (uint32_t i = 0; i < vh.aisleCount; ++i, a += 4)
+        aisleRects.push_back({ a[0] * scale + offX, a[1] * scale + offY, a[2] * scale, a[3] * scale });
+    entrancePos = { vh.entranceX * scale + offX, vh.entranceY * scale + offY };
+    picker.reset(new BinPicker(seatMap));
+}
+
+// All seat state changes of the mirror go through here
+void Theater::applySeatState(int idx, int state) {
+    if (seatMap.state(idx) == state) return;
+    seatMap.setState(idx, (uint8_t)state);
+    freeSeats.setFree(seatMap.row(idx), seatMap.col(idx), state == 0);
+    versions.set(idx, (uint8_t)state);
+    ++holdGen[idx];
+    if (state == 1) holdTimers.schedule((uint64_t)((bookingClock + HOLD_TTL) / HOLD_TICK), idx, holdGen[idx]);
+    if (!isDirty[idx]) { isDirty[idx] = 1; dirty.push_back(idx); }
+}
+
+void Theater::clearDirtySeats() {
+    for (int idx : dirty) isDirty[idx] = 0;
+    dirty.clear();
+}
+
+// Copies what changed on the engine into the mirror and the log. A seat caught in
+// the middle of a group acquisition is looked at again on the next call.
+void Theater::pullChanges(bool log) {
+    changedSeats.swap(lockedSeats);
+    lockedSeats.clear();
+    engine->collectChanges(changedSeats);
+    for (int idx : changedSeats) {
+        uint8_t state = engine->state(idx);
+        if (state == SEAT_LOCKED) { lockedSeats.push_back(idx); continue; }
+        if (seatMap.state(idx) == state) continue;
+        applySeatState(idx, state);
+        if (log) seatLog.logState(idx, state);
+    }
+    changedSeats.clear();
+    versions.publish();
+}
+
+void Theater::syncBookings() { pullChanges(true); }
+
+void Theater::resetSeats() {
+    const uint8_t* state = seatMap.stateData();
+    for (int i = 0; i < seatMap.size(); ++i) if (state[i] == 1 || state[i] == 2) applySeatState(i, 0);
+}
+
+void Theater::toggleSeat(int idx) {
+    if (idx < 0) return;
+    engine->toggle(idx);
+    syncBookings();
+}
+
+bool Theater::buyNSeats(int n) {
+    if (n <= 0 || n > seatMap.cols()) return false; // invalid request or impossible to fit in a row
+
+    // By default: rows from last (closest to screen bottom) to first (top), right-most block
+    // of the first row that has one. We stop after the first block found (per spec).
+    // A client may take part of the block first; the allocator then learns about it
+    // from the sync and the next find looks elsewhere.
+    int r, start;
+    block.resize(n);
+    for (;;) {
+        syncBookings();
+        if (!freeSeats.find(n, policy, r, start)) return false;
+        for (int k = 0; k < n; ++k) block[k] = seatMap.index(r, start + k);
+        if (engine->acquire(block.data(), n, SEAT_BOUGHT)) break;
+    }
+    syncBookings();
+    return true;
+}
+
+bool Theater::openLog(const char* path) {
+    std::string snapshotPath = std::string(path) + ".snap";
+    SeatSnapshot snapshot;
+    uint64_t snapshotLsn = 0;
+    if (loadSnapshot(snapshotPath.c_str(), snapshot)) {
+        if (snapshot.rows == (uint32_t)seatMap.rows() && snapshot.cols == (uint32_t)seatMap.cols()) {
+            for (int i = 0; i < seatMap.size(); ++i)
+                if (seatMap.state(i) != 3 && snapshot.states[i] != 3) applySeatState(i, snapshot.states[i]);
+            snapshotLsn = snapshot.lsn;
+        }
+        else std::cerr << snapshotPath << " was taken of a different hall, ignored\n";
+    }
+
+    unsigned long long applied = 0;
+    uint64_t lastLsn = 0;
+    bool ok = SeatLog::replay(path, snapshotLsn, [&](const SeatLogRecord& r) {
+        ++applied;
+        if (r.type == SeatLogRecord::RESET) { resetSeats(); return; }
+        if (r.seat >= (uint32_t)seatMap.size() || r.state > 2 || seatMap.state(r.seat) == 3) return; // other layout
+        applySeatState((int)r.seat, r.state);
+    }, lastLsn);
+    if (!ok || !seatLog.open(path, lastLsn)) return false;
+    // the engine takes the recovered states; nobody else can hold it yet
+    engine.reset(new BookingEngine(seatMap.rows(), seatMap.cols(), seatMap.stateData()));
+    engine->setBlockPolicy(policy);
+    versions.publish();
+    checkpointer.start(snapshotPath.c_str());
+    checkpointedLsn = trimmedLsn = snapshotLsn;
+    std::cout << "recovered snapshot at " << snapshotLsn << " + " << applied << " seat changes from " << path << "\n";
+    return true;
+}
+
+void Theater::closeLog() {
+    checkpointer.stop(); // finishes a snapshot in flight
+    seatLog.close();
+}
+
+// Hands a copy of the states to the checkpointer when enough has been logged since
+// the last snapshot, and trims the log behind every finished one
+void Theater::checkpoint() {
+    if (!seatLog.isOpen()) return;
+    uint64_t done = checkpointer.completedLsn();
+    if (done > trimmedLsn) { seatLog.trim(done); trimmedLsn = done; }
+    uint64_t lsn = seatLog.appendedLsn();
+    if (lsn - checkpointedLsn < CHECKPOINT_EVERY) return;
+    if (checkpointer.request(seatMap.stateData(), (uint32_t)seatMap.rows(), (uint32_t)seatMap.cols(), lsn)) checkpointedLsn = lsn;
+}
+
+// Frees reservations whose hold ran out; they go back to the allocator through syncBookings()
+void Theater::expireHolds() {
+    expiredHolds.clear();
+    holdTimers.advance((uint64_t)(bookingClock / HOLD_TICK), expiredHolds);
+    // once the film has started, reserved seats are taken by the audience
+    if (running) return;
+    for (const TimerWheel::Expired& e : expiredHolds)
+        if (e.tag == holdGen[e.id] && seatMap.state(e.id) == 1) engine->release(e.id);
+    if (!expiredHolds.empty()) syncBookings();
+}
+
+void Theater::update(double elapsed) {
+    bookingClock += elapsed;
+    syncBookings();
+    expireHolds();
+    checkpoint();
+
+    simAccumulator += std::min((float)elapsed, MAX_FRAME_DT);
+    while (simAccumulator >= SIM_DT) {
+        updateSimulation(SIM_DT);
+        simAccumulator -= SIM_DT;
+    }
+    alpha = simAccumulator / SIM_DT;
+}
+
+void Theater::startSimulation() {
+    crowd.clear();
+    syncBookings();
+    std::vector<int> seatIndices;
+    const uint8_t* state = seatMap.stateData();
+    for (int i = 0; i < seatMap.size(); ++i) {
+        if (state[i] == 1 || state[i] == 2) {
+            seatIndices.push_back(i);
+        }
+    }
+    if (seatIndices.empty()) return;
+
+    int totalPossible = (int)seatIndices.size();
+    std::random_device rd;
+    std::mt19937 g(seed ? seed : rd());
+    std::shuffle(seatIndices.begin(), seatIndices.end(), g);
+
+    std::uniform_int_distribution<int> distNum(1, totalPossible);
+    int numPeople = distNum(g);
+
+    seatedTime = 0.0f;
+    exitDuration = 0.0f;
+    for (int i = 0; i < numPeople; ++i) {
+        int si = seatIndices[i];
+        Person p;
+        p.seated = false; p.exiting = false; p.seatIndex = si;
+        p.pos = entrancePos;
+        p.prevPos = p.pos;
+        SeatRect s = seatMap.rect(si);
+        p.finalTarget = { s.x + s.w * 0.5f, s.y + s.h * 0.5f };
+        // rowTarget: keep entrance X, target Y = row's center (move vertically toward row Y)
+        p.rowTarget = { p.pos.x, p.finalTarget.y };
+        p.reachedRow = false;
+        p.target = p.finalTarget; // not used until exiting
+        crowd.push_back(p);
+
+        // phase boundaries of the analytic crowd
+        float walk = distance(p.rowTarget, p.pos) + distance(p.finalTarget, p.rowTarget);
+        seatedTime = std::max(seatedTime, walk / WALK_SPEED);
+        exitDuration = std::max(exitDuration, distance(entrancePos, p.finalTarget) / EXIT_SPEED);
+    }
+
+    ++crowdGeneration;
+    simTime = 0.0f;
+    exitAt = -1.0f;
+    running = true;
+    filmTimer = 0.0f;
+    colorTimer = 0.0f;
+}
+
+float Theater::crowdTime() const {
+    // simTime is the current tick, draw at the interpolated point since the previous one
+    return std::max(0.0f, simTime - (1.0f - alpha) * SIM_DT);
+}
+
+void Theater::randomizeFilmColor() {
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::uniform_real_distribution<float> d(0.1f, 0.7f);
+    film = { d(g), d(g), d(g), 1.0f };
+}
+
+void Theater::endSimulation() {
+    crowd.clear();
+    syncBookings();
+    seatLog.logReset();
+    engine->reset();
+    pullChanges(false);
+    running = false;
+    // reset film color
+    film = { 0.05f, 0.05f, 0.2f, 1.0f };
+}
+
+void Theater::updateCrowdClock(float dt) {
+    simTime += dt;
+    if (exitAt < 0.0f && simTime >= seatedTime) {
+        filmTimer = simTime - seatedTime;
+        colorTimer += dt;
+        if (colorTimer >= FILM_COLOR_EVERY) { colorTimer -= FILM_COLOR_EVERY; randomizeFilmColor(); }
+        if (filmTimer >= filmTime) {
+            film = { 1.0f, 1.0f, 1.0f, 1.0f };
+            exitAt = simTime;
+        }
+    }
+    if (exitAt >= 0.0f && simTime >= exitAt + exitDuration) endSimulation();
+}
+
+void Theater::updateSimulation(float dt) {
+    if (!running) return;
+    if (analyticCrowd) { updateCrowdClock(dt); return; }
+
+    for (auto& p : crowd) p.prevPos = p.pos;
+
+    bool allSeated = true;
+    // Move people toward their seats: first vertically to their row (keeping the
+    // entrance x), then along it to the seat
+    for (auto& p : crowd) {
+        if (!p.seated && !p.exiting) {
+            allSeated = false;
+            if (!p.reachedRow) p.reachedRow = stepTowards(p.pos, p.rowTarget, WALK_SPEED, dt);
+            else p.seated = stepTowards(p.pos, p.finalTarget, WALK_SPEED, dt);
+        }
+    }
+
+    // Only if all are seated, run film timer
+    if (allSeated) {
+        filmTimer += dt;
+        colorTimer += dt;
+        if (colorTimer >= FILM_COLOR_EVERY) { colorTimer -= FILM_COLOR_EVERY; randomizeFilmColor(); } // randomize color periodically
+        if (filmTimer >= filmTime) {
+            // start exiting: set target to entrance for each person
+            film = { 1.0f, 1.0f, 1.0f, 1.0f };
+            for (auto& p : crowd) {
+                p.exiting = true;
+                p.seated = false;
+                p.target = entrancePos;
+                p.reachedRow = false;
+            }
+        }
+    }
+
+    // Handle exiting movement; everybody is gone once all stand at the entrance
+    bool allGone = true;
+    for (auto& p : crowd) {
+        if (p.exiting) stepTowards(p.pos, p.target, EXIT_SPEED, dt);
+        if (!(p.exiting && distance(p.pos, p.target) < 2.0f)) allGone = false;
+    }
+
+    if (allGone && filmTimer >= filmTime) endSimulation();
+}
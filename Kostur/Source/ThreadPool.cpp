@@ -0,0 +1,59 @@
+#include "../Header/ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int workerCount) {
+    for (int i = 0; i < workerCount; ++i) workers.emplace_back([this] { work(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+void ThreadPool::drain() {
+    for (;;) {
+        int begin = next.fetch_add(step, std::memory_order_relaxed);
+        if (begin >= total) return;
+        chunk(context, begin, std::min(total, begin + step));
+    }
+}
+
+void ThreadPool::work() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return quit || generation != seen; });
+            if (quit) return;
+            seen = generation;
+        }
+        drain();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) finished.notify_one();
+    }
+}
+
+void ThreadPool::dispatch(int count, int grain, Chunk fn, void* ctx) {
+    if (count <= 0) return;
+    grain = std::max(1, grain);
+    if (workers.empty() || count <= grain) { // not worth waking anybody
+        for (int begin = 0; begin < count; begin += grain) fn(ctx, begin, std::min(count, begin + grain));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunk = fn; context = ctx;
+        total = count; step = grain;
+        next.store(0, std::memory_order_relaxed);
+        running = (int)workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+    drain();
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return running == 0; });
+}
@@ -0,0 +1,73 @@
+#include "../Header/TimerWheel.h"
+
+TimerWheel::TimerWheel() {
+    for (auto& level : heads)
+        for (int& head : level) head = -1;
+}
+
+void TimerWheel::schedule(uint64_t expiryTick, uint32_t id, uint32_t tag) {
+    int node;
+    if (freeList >= 0) { node = freeList; freeList = nodes[node].next; }
+    else { node = (int)nodes.size(); nodes.push_back(Node()); }
+    // a timer that is already due fires on the next tick
+    nodes[node] = { expiryTick > current ? expiryTick : current + 1, id, tag, -1 };
+    ++pendingCount;
+    insert(node);
+}
+
+// Level l holds timers 64^l .. 64^(l+1) - 1 ticks away, in the slot of their expiry
+// at that level's resolution; anything further waits in the top level
+void TimerWheel::insert(int node) {
+    uint64_t expiry = nodes[node].expiry;
+    uint64_t delta = expiry - current;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1ull << (SLOT_BITS * (level + 1)))) ++level;
+    uint64_t at = expiry;
+    if (level == LEVELS - 1 && delta >= (1ull << (SLOT_BITS * LEVELS))) {
+        at = current + (1ull << (SLOT_BITS * LEVELS)) - 1; // re-filed when this slot turns
+    }
+    int slot = (int)((at >> (SLOT_BITS * level)) & (SLOTS - 1));
+    nodes[node].next = heads[level][slot];
+    heads[level][slot] = node;
+}
+
+int TimerWheel::detach(int level, int slot) {
+    int list = heads[level][slot];
+    heads[level][slot] = -1;
+    return list;
+}
+
+void TimerWheel::release(int node) {
+    nodes[node].next = freeList;
+    freeList = node;
+    --pendingCount;
+}
+
+void TimerWheel::advance(uint64_t tick, std::vector<Expired>& out) {
+    while (current < tick) {
+        ++current;
+        // entering a new slot of a higher level: spread its timers over the levels below,
+        // top level first so nothing it moves down is missed
+        int top = 0;
+        while (top < LEVELS - 1 && (current & ((1ull << (SLOT_BITS * (top + 1))) - 1)) == 0) ++top;
+        for (int level = top; level >= 1; --level) {
+            int slot = (int)((current >> (SLOT_BITS * level)) & (SLOTS - 1));
+            for (int n = detach(level, slot); n >= 0; ) {
+                int next = nodes[n].next;
+                insert(n);
+                n = next;
+            }
+        }
+
+        int slot = (int)(current & (SLOTS - 1));
+        for (int n = detach(0, slot); n >= 0; ) {
+            int next = nodes[n].next;
+            if (nodes[n].expiry <= current) {
+                out.push_back({ nodes[n].id, nodes[n].tag });
+                release(n);
+            }
+            else insert(n);
+            n = next;
+        }
+    }
+}
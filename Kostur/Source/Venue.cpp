@@ -0,0 +1,192 @@
+#include "../Header/Venue.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const uint8_t SLOT_SEAT = 0;
+    const uint8_t SLOT_EMPTY = 3;
+
+    struct Slot { float x, y, w, h; uint8_t state; };
+
+    uint64_t align64(uint64_t v) { return (v + 63) & ~(uint64_t)63; }
+}
+
+bool compileVenue(const char* textPath, const char* binaryPath) {
+    std::ifstream in(textPath);
+    if (!in) { std::cerr << "Cannot open venue " << textPath << "\n"; return false; }
+
+    VenueHeader h = {};
+    std::memcpy(h.magic, "VENU", 4);
+    h.version = VENUE_VERSION;
+    std::vector<std::vector<Slot>> rows;
+    std::vector<float> aisles;
+    float rowY = 0.0f, rowH = 0.0f;
+
+    std::string line;
+    for (int lineNo = 1; std::getline(in, line); ++lineNo) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream ss(line);
+        std::string cmd;
+        if (!(ss >> cmd)) continue;
+
+        bool ok = true;
+        bool needsRow = cmd == "seats" || cmd == "seat" || cmd == "gap";
+        if (needsRow && rows.empty()) {
+            std::cerr << textPath << ":" << lineNo << ": '" << cmd << "' before the first row\n";
+            return false;
+        }
+        if (cmd == "venue") ok = (bool)(ss >> h.width >> h.height);
+        else if (cmd == "entrance") ok = (bool)(ss >> h.entranceX >> h.entranceY);
+        else if (cmd == "aisle") {
+            float a[4];
+            ok = (bool)(ss >> a[0] >> a[1] >> a[2] >> a[3]);
+            if (ok) aisles.insert(aisles.end(), a, a + 4);
+        }
+        else if (cmd == "row") {
+            ok = (bool)(ss >> rowY >> rowH);
+            rows.emplace_back();
+        }
+        else if (cmd == "seats") {
+            float x, w, pitch; int count;
+            ok = (bool)(ss >> x >> w >> pitch >> count) && count > 0;
+            for (int i = 0; ok && i < count; ++i) rows.back().push_back({ x + i * pitch, rowY, w, rowH, SLOT_SEAT });
+        }
+        else if (cmd == "seat") {
+            Slot s = { 0, 0, 0, 0, SLOT_SEAT };
+            ok = (bool)(ss >> s.x >> s.y >> s.w >> s.h);
+            if (ok) rows.back().push_back(s);
+        }
+        else if (cmd == "gap") {
+            int count;
+            ok = (bool)(ss >> count) && count > 0;
+            for (int i = 0; ok && i < count; ++i) rows.back().push_back({ 0, 0, 0, 0, SLOT_EMPTY });
+        }
+        else {
+            std::cerr << textPath << ":" << lineNo << ": unknown directive '" << cmd << "'\n";
+            return false;
+        }
+        if (!ok) { std::cerr << textPath << ":" << lineNo << ": bad arguments for '" << cmd << "'\n"; return false; }
+    }
+    if (rows.empty() || h.width <= 0.0f || h.height <= 0.0f) {
+        std::cerr << textPath << ": a venue needs a 'venue W H' line and at least one row\n";
+        return false;
+    }
+
+    h.rows = (uint32_t)rows.size();
+    for (const auto& r : rows) h.cols = std::max(h.cols, (uint32_t)r.size());
+    h.aisleCount = (uint32_t)(aisles.size() / 4);
+    uint64_t n = (uint64_t)h.rows * h.cols;
+    h.rectsOffset = align64(sizeof(VenueHeader));
+    h.slotsOffset = align64(h.rectsOffset + 4 * n * sizeof(float));
+    h.aislesOffset = align64(h.slotsOffset + n);
+    h.fileSize = h.aislesOffset + aisles.size() * sizeof(float);
+
+    std::vector<uint8_t> out(h.fileSize, 0);
+    std::memcpy(out.data(), &h, sizeof(h));
+    float* rects = (float*)(out.data() + h.rectsOffset);
+    uint8_t* slots = out.data() + h.slotsOffset;
+    for (uint32_t r = 0; r < h.rows; ++r) {
+        for (uint32_t c = 0; c < h.cols; ++c) {
+            uint64_t i = (uint64_t)r * h.cols + c;
+            Slot s = c < rows[r].size() ? rows[r][c] : Slot{ 0, 0, 0, 0, SLOT_EMPTY };
+            rects[i] = s.x; rects[n + i] = s.y; rects[2 * n + i] = s.w; rects[3 * n + i] = s.h;
+            slots[i] = s.state;
+        }
+    }
+    if (!aisles.empty()) std::memcpy(out.data() + h.aislesOffset, aisles.data(), aisles.size() * sizeof(float));
+
+    FILE* f = std::fopen(binaryPath, "wb");
+    if (!f) { std::cerr << "Cannot write " << binaryPath << "\n"; return false; }
+    bool written = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    written = std::fclose(f) == 0 && written;
+    if (!written) { std::cerr << "Failed writing " << binaryPath << "\n"; return false; }
+    std::cout << "venue " << binaryPath << ": " << h.rows << " rows x " << h.cols << " slots, "
+              << std::count(slots, slots + n, SLOT_SEAT) << " seats, " << h.aisleCount << " aisles\n";
+    return true;
+}
+
+bool VenueFile::open(const char* path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { std::cerr << "Cannot open venue " << path << "\n"; return false; }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        std::cerr << "Cannot map venue " << path << "\n"; return false;
+    }
+    fileHandle = file; mappingHandle = mapping;
+    data = (const uint8_t*)view;
+    size = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) { std::cerr << "Cannot open venue " << path << "\n"; return false; }
+    struct stat st;
+    void* view = fstat(fd, &st) == 0 && st.st_size > 0
+        ? mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd); // the mapping keeps the file alive
+    if (view == MAP_FAILED) { std::cerr << "Cannot map venue " << path << "\n"; return false; }
+    data = (const uint8_t*)view;
+    size = (size_t)st.st_size;
+#endif
+
+    // only the header is checked, the arrays are used as they are
+    if (size < sizeof(VenueHeader)) {
+        std::cerr << path << " is too small for a venue file\n";
+        close();
+        return false;
+    }
+    const VenueHeader& h = header();
+    uint64_t n = (uint64_t)h.rows * h.cols;
+    bool valid = std::memcmp(h.magic, "VENU", 4) == 0
+        && h.fileSize == size
+        && h.rectsOffset % 64 == 0 && h.rectsOffset + 4 * n * sizeof(float) <= size
+        && h.slotsOffset + n <= size
+        && h.aislesOffset % 4 == 0 && h.aislesOffset + (uint64_t)h.aisleCount * 4 * sizeof(float) <= size;
+    if (!valid || h.version != VENUE_VERSION) {
+        std::cerr << path << " is not a version " << VENUE_VERSION << " venue file\n";
+        close();
+        return false;
+    }
+    if (!(h.width > 0.0f && h.height > 0.0f)) { // the layout is scaled by them
+        std::cerr << path << ": venue size must be positive\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void VenueFile::close() {
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle((HANDLE)mappingHandle);
+    CloseHandle((HANDLE)fileHandle);
+    fileHandle = mappingHandle = nullptr;
+#else
+    munmap((void*)data, size);
+#endif
+    data = nullptr;
+    size = 0;
+}